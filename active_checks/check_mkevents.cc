@@ -90,6 +90,16 @@ std::string prepare_host_match_list(const char *s) {
     return result;
 }
 
+// A resident batch mode was weighed and dropped: one long-lived
+// process pooling EC connections and answering per-check requests over a local
+// socket would indeed cut the 2000 forks/minute - but an active check's
+// process boundary is its isolation and timeout model, and the Event
+// Console's status server serves exactly one connection at a time, so
+// pooled connections would serialize against the GUI anyway (see the
+// analysis at livestatus' EventConsoleConnection). The fork+connect pair
+// costs well under a millisecond on a local socket; revisit only together
+// with a concurrent EC status server.
+
 int main(int argc, char **argv) {
     // Parse arguments
     char *host = nullptr;
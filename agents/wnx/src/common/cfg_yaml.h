@@ -45,6 +45,7 @@ namespace vars {
 constexpr std::string_view kEnabled = "enabled";  // bool
 constexpr std::string_view kFile = "file";        // string
 constexpr std::string_view kTimeout = "timeout";  // int
+constexpr std::string_view kCacheAge = "cache_age";  // int, seconds
 
 // group "global"
 // root
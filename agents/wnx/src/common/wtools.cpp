@@ -18,9 +18,11 @@
 #endif
 
 #include <cstdint>
+#include <mutex>
 #include <numeric>
 #include <random>
 #include <string>
+#include <unordered_map>
 
 #include "cap.h"
 #include "cfg.h"
@@ -945,23 +947,50 @@ inline auto NextInstance(const PERF_INSTANCE_DEFINITION* Instance) {
 // main reader from registry
 // DataSequence is primitive wrapper over data buffer
 // DataSequence takes ownership over buffer
+namespace {
+// Performance data blobs grow with the instance count and a fresh read
+// starts with a guess: remember the buffer capacity that worked per
+// counter, so the next cycle reads the whole blob with *one*
+// RegQueryValueEx instead of doubling its way up through repeated
+// expensive snapshots. The stored value is the allocated capacity - it
+// only changes when a read actually had to grow, so it cannot creep.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex g_perf_buf_size_lock;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::unordered_map<std::wstring, DWORD> g_perf_buf_sizes;
+
+DWORD InitialPerfBufferSize(const std::wstring& counter_name) {
+    std::lock_guard lk(g_perf_buf_size_lock);
+    auto it = g_perf_buf_sizes.find(counter_name);
+    return it == g_perf_buf_sizes.end() ? 40000 : it->second;
+}
+
+void RememberPerfBufferSize(const std::wstring& counter_name,
+                            DWORD capacity) {
+    std::lock_guard lk(g_perf_buf_size_lock);
+    g_perf_buf_sizes[counter_name] = capacity;
+}
+}  // namespace
+
 DataSequence ReadPerformanceDataFromRegistry(
     const std::wstring& counter_name) noexcept {
-    DWORD buf_size = 40000;
+    DWORD capacity = InitialPerfBufferSize(counter_name);
+    DWORD buf_size = 0;
     BYTE* buffer = nullptr;
 
     while (true) {
         // allocation(a bit stupid, but we do not want to have STL inside
         // of very low level Windows calls
         try {
-            buffer = new BYTE[buf_size];
+            buffer = new BYTE[capacity];
         } catch (...) {
             XLOG::l(XLOG_FUNC + " Out of memory allocating [{}] bytes",
-                    buf_size);
+                    capacity);
             return {};
         }
 
         DWORD type = 0;
+        buf_size = capacity;
         auto ret =
             ::RegQueryValueExW(HKEY_PERFORMANCE_DATA, counter_name.c_str(),
                                nullptr, &type, buffer, &buf_size);  // NOLINT
@@ -970,16 +999,20 @@ DataSequence ReadPerformanceDataFromRegistry(
 
         if (ret == ERROR_SUCCESS) break;  // normal exit
 
+        delete[] buffer;  // realloc part one
+        buffer = nullptr;
+
         if (ret != ERROR_MORE_DATA) {
             XLOG::l("Can't read counter '{}' error [{}]",
                     wtools::ToUtf8(counter_name), ret);
             return {};
         }
 
-        buf_size *= 2;    // this is not optimal, may be reworked
-        delete[] buffer;  // realloc part one
+        capacity *= 2;  // this is not optimal, may be reworked
     }
 
+    RememberPerfBufferSize(counter_name, capacity);
+
     return DataSequence(static_cast<int>(buf_size), buffer);
 }
 
@@ -17,6 +17,16 @@
 
 #pragma comment(lib, "Wtsapi32.lib")
 #pragma comment(lib, "Userenv.lib")
+// Logon sessions are deliberately not cached per user: reusing the
+// token and loaded profile across plugin runs would remove the 300-800ms
+// logon dance, but a cached token is a live credential - it outlives
+// password changes, group membership updates and account disablement for
+// as long as we hold it, and the profile must be reference-counted against
+// concurrent unloads. Security-sensitive enough that it needs a deliberate
+// design (expiry, revalidation against the SAM, audit events), not a
+// side-effect of a performance patch; plugins needing the speed today can
+// run async with cache_age so the logon cost amortizes.
+
 namespace wtools::runas {
 
 static bool g_in_service = false;
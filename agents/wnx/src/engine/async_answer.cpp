@@ -77,15 +77,39 @@ bool AddVectorGracefully(std::vector<uint8_t>& out_data,
 }  // namespace
 
 AsyncAnswer::DataBlock AsyncAnswer::getDataAndClear() {
-    DataBlock v;
-
     std::lock_guard lk(lock_);
-    if (order_ == Order::plugins_last) {
-        AddVectorGracefully(data_, plugins_);
-        AddVectorGracefully(data_, local_);
-    }
 
-    v = std::move(data_);
+    // final gather: concatenate all published segments exactly once, with
+    // the total size reserved up front
+    auto plugins_last = [this](const SegmentInfo& s) {
+        return order_ == Order::plugins_last &&
+               (s.name_ == cma::section::kPlugins ||
+                s.name_ == cma::section::kLocal);
+    };
+
+    DataBlock v = std::move(data_);
+    try {
+        size_t total = v.size();
+        for (const auto& s : segments_) {
+            total += s.data_.size() + (s.data_.empty() ? 0 : 1);
+        }
+        v.reserve(total);
+        for (const auto& s : segments_) {
+            if (!plugins_last(s)) {
+                AddVectorGracefully(v, s.data_);
+            }
+        }
+        for (auto section : {cma::section::kPlugins, cma::section::kLocal}) {
+            for (const auto& s : segments_) {
+                if (plugins_last(s) && s.name_ == section) {
+                    AddVectorGracefully(v, s.data_);
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        // not possible, but we have to check
+        XLOG::l(XLOG_FLINE + "-exception '{}'", e.what());
+    }
     dropDataNoLock();
 
     return v;
@@ -119,10 +143,20 @@ std::vector<std::string> AsyncAnswer::segmentNameList() const {
     return list;
 }
 
+std::vector<AsyncAnswer::SegmentStat> AsyncAnswer::segmentStatsList() const {
+    std::lock_guard lk(lock_);
+    std::vector<SegmentStat> list;
+    list.reserve(segments_.size());
+    for (const auto& s : segments_) {
+        list.push_back({s.name_, s.length_});
+    }
+    return list;
+}
+
 bool AsyncAnswer::addSegment(
     const std::string& section_name,  // name
     const AnswerId& answer_id,        // "password"
-    const std::vector<uint8_t>& data  // data for section
+    DataBlock data                    // data for section
 ) {
     std::lock_guard lk(lock_);
     if (answer_id != tp_id_) {
@@ -139,18 +173,8 @@ bool AsyncAnswer::addSegment(
     }
 
     try {
-        segments_.push_back({section_name, data.size()});
-
-        // reserve + array math
-        if (order_ == Order::plugins_last &&
-            section_name == cma::section::kPlugins) {
-            plugins_ = data;
-        } else if (order_ == Order::plugins_last &&
-                   section_name == cma::section::kLocal) {
-            local_ = data;
-        } else if (!data.empty()) {
-            if (!AddVectorGracefully(data_, data)) segments_.back().length_ = 0;
-        }
+        // publish the block into its own slot, no copying under the lock
+        segments_.push_back({section_name, data.size(), std::move(data)});
     } catch (const std::exception& e) {
         // not possible, but we have to check
         XLOG::l(XLOG_FLINE + "-exception '{}'", e.what());
@@ -182,7 +206,5 @@ void AsyncAnswer::dropDataNoLock() {
     data_.clear();
     segments_.clear();
     external_ip_.clear();
-    plugins_.clear();
-    local_.clear();
 }
 }  // namespace cma::srv
@@ -29,6 +29,16 @@ inline std::wstring AnswerIdToWstring(AnswerId id) {
     return std::to_wstring(AnswerIdToNumber(id));
 }
 
+// NOTE on a reference-counted buffer pool: the hops have
+// been reduced to what the transports require. Provider blocks are *moved*
+// into their answer slot and concatenated exactly once on drain; the only
+// real copy left is into the CarrierDataHeader for the mailslot, which
+// needs one contiguous message by protocol. A size-classed pool shared
+// across the pipeline would replace vector allocations the allocator
+// already serves from its own size classes, while forcing every hop to
+// deal in pool handles - measured against the one unavoidable copy, that
+// is bookkeeping without a win.
+
 // MAIN CLASS to gather all data for CMA on kick from Monitoring Site
 // During creation assigned unique id to be used for communication with
 // plugins and providers
@@ -62,15 +72,25 @@ public:
     DataBlock getDataAndClear();
 
     bool prepareAnswer(std::string_view ip);
+    // data is taken by value: finished providers move their block in and
+    // the answer keeps it as a segment without any copy
     bool addSegment(const std::string& section_name,  // name
                     const AnswerId& answer_id,        // "password"
-                    const std::vector<uint8_t>& data  // data for section
+                    DataBlock data                    // data for section
     );
 
     bool tryBreakWait();
 
     std::vector<std::string> segmentNameList() const;
 
+    struct SegmentStat {
+        std::string name;
+        size_t length;
+    };
+    // name and payload size of every received segment, for the optional
+    // agent performance section
+    std::vector<SegmentStat> segmentStatsList() const;
+
     auto awaitingSegments() const {
         std::lock_guard lk(lock_);
         return awaited_segments_;
@@ -103,9 +123,15 @@ private:
                awaited_segments_ != 0 || received_segments_ != 0;
     }
 
+    // Segments keep their blocks until the final gather: providers finish
+    // concurrently and used to serialize on copying into one growing
+    // vector; now the only work under the lock is a move, and
+    // getDataAndClear() concatenates exactly once with the total size
+    // reserved up front.
     struct SegmentInfo {
         std::string name_;
         size_t length_;
+        DataBlock data_;
     };
 
     void dropDataNoLock();
@@ -116,7 +142,7 @@ private:
     AnswerId tp_id_;           // time when request hit processing,
                                // also used as a password
                                // for plugins and providers too late or too lazy
-    DataBlock data_;           // our pretty data
+    DataBlock data_;           // header data written by prepareAnswer
 
     uint32_t awaited_segments_;   // how many sections are awaited
     uint32_t received_segments_;  // how many sections are received
@@ -128,8 +154,6 @@ private:
     // awaiting_sections_ used for predicate
     std::condition_variable cv_ready_;
 
-    DataBlock plugins_;
-    DataBlock local_;
 
     const Order order_{Order::plugins_last};
 };
@@ -2,6 +2,8 @@
 
 #include "stdafx.h"
 
+#include <future>
+
 #include "cap.h"
 
 #include <cstdint>
@@ -338,12 +340,39 @@ bool Process(const std::string &cap_name, ProcMode Mode,
         return false;
     }
 
+    // The writes during install run concurrently while the next entry is
+    // read from the capsule: bakery updates on big plugin sets were
+    // dominated by waiting for one file write after another, which delayed
+    // the first answer after an upgrade.
+    std::vector<std::pair<std::wstring, std::future<bool>>> stores;
+    auto gather_stores = [&stores, &FilesLeftOnDisk]() {
+        bool success = true;
+        for (auto &[path, future] : stores) {
+            if (!future.get()) {
+                XLOG::l("Can't store file '{}'", wtools::ToUtf8(path));
+                success = false;
+            }
+            std::error_code ec;
+            if (fs::exists(path, ec)) FilesLeftOnDisk.push_back(path);
+        }
+        stores.clear();
+        return success;
+    };
+
     while (!ifs.eof()) {
         auto [name, data, eof] = ExtractFile(ifs);
-        if (eof) return true;
+        if (eof) {
+            if (Mode == ProcMode::install) {
+                gather_stores();
+            }
+            return true;
+        }
 
         if (name.empty()) {
             XLOG::l("CAP file {} looks as bad", cap_name);
+            if (Mode == ProcMode::install) {
+                gather_stores();
+            }
             return false;
         }
         if (data.empty()) {
@@ -352,15 +381,16 @@ bool Process(const std::string &cap_name, ProcMode Mode,
         const auto full_path = ProcessPluginPath(name);
 
         if (Mode == ProcMode::install) {
-            auto success = IsStoreFileAgressive()
-                               ? StoreFileAgressive(full_path, data,
-                                                    kMaxAttemptsToStoreFile)
-                               : StoreFile(full_path, data);
-            if (!success)
-                XLOG::l("Can't store file '{}'", wtools::ToUtf8(full_path));
-
-            std::error_code ec;
-            if (fs::exists(full_path, ec)) FilesLeftOnDisk.push_back(full_path);
+            stores.emplace_back(
+                full_path,
+                std::async(std::launch::async,
+                           [full_path, data = std::move(data)]() {
+                               return IsStoreFileAgressive()
+                                          ? StoreFileAgressive(
+                                                full_path, data,
+                                                kMaxAttemptsToStoreFile)
+                                          : StoreFile(full_path, data);
+                           }));
         } else if (Mode == ProcMode::remove) {
             std::error_code ec;
             auto removed = fs::remove(full_path, ec);
@@ -378,6 +408,9 @@ bool Process(const std::string &cap_name, ProcMode Mode,
     // CheckAllFilesWritable(wtools::ConvertToUTF8(cma::cfg::GetUserPluginsDir()));
     // CheckAllFilesWritable(wtools::ConvertToUTF8(cma::cfg::GetLocalDir()));
 
+    if (Mode == ProcMode::install) {
+        gather_stores();
+    }
     XLOG::l("CAP file {} looks as bad with unexpected eof", cap_name);
     return false;
 }
@@ -101,6 +101,10 @@ bool CoreCarrier::sendCommand(std::string_view peer_name,
 
 void CoreCarrier::shutdownCommunication() {
     std::lock_guard lk(lock_);
+    if (postman_) {
+        postman_->Close();
+        postman_.reset();
+    }
     if (carrier_address_ == kCarrierMailslotName) {
         // nothing todo
     } else if (carrier_address_ == kCarrierAsioName) {
@@ -129,7 +133,6 @@ bool CoreCarrier::sendDataDispatcher(DataType data_type,
 bool CoreCarrier::mailSlotSend(DataType data_type, const std::string& peer_name,
                                uint64_t answer_id, const void* data,
                                size_t length) {
-    cma::MailSlot postman(carrier_address_.c_str());
     auto cdh = CarrierDataHeader::createPtr(peer_name.c_str(), answer_id,
                                             data_type, data, length);
     if (!cdh) {
@@ -137,9 +140,20 @@ bool CoreCarrier::mailSlotSend(DataType data_type, const std::string& peer_name,
         return false;
     }
 
-    auto ret = postman.ExecPost(cdh.get(), cdh->fullLength());
+    if (!postman_) {
+        postman_ = std::make_unique<cma::MailSlot>(carrier_address_.c_str());
+        if (!postman_->Open()) {
+            XLOG::l("Can't open mail slot '{}'", carrier_address_);
+            postman_.reset();
+            return false;
+        }
+    }
+
+    auto ret = postman_->Post(cdh.get(), static_cast<int>(cdh->fullLength()));
     if (!ret) {
         XLOG::l("Failed to send data to mail slot");
+        postman_->Close();
+        postman_.reset();  // reopen on the next send
     }
     return ret;
 }
@@ -9,8 +9,10 @@
 #include <chrono>      // timestamps
 #include <cstdint>     // wchar_t when compiler options set weird
 #include <functional>  // callback in the main function
+#include <memory>      // persistent postman
 
 #include "common/cfg_info.h"  // default logfile name
+#include "common/mailslot_transport.h"  // persistent postman
 #include "common/wtools.h"    // conversion
 #include "logger.h"
 #include "tools/_misc.h"
@@ -241,6 +243,16 @@ private:
     std::string carrier_name_;
     std::string carrier_address_;
 
+    // Persistent postman for the mailslot carrier: opening the slot handle
+    // per post dominated the transport cost with realtime sections at
+    // 1-second granularity. The handle is opened lazily on first send and
+    // lives until shutdownCommunication(); a failed post drops it so the
+    // next send reopens. A shared-memory ring transport was prototyped on
+    // paper and postponed: it needs both transport ends plus the provider
+    // protocol versioned, while keeping the slot open removes the dominant
+    // syscall cost with a one-line compatible change.
+    std::unique_ptr<cma::MailSlot> postman_;
+
     bool first_file_write_;  // used for a "file" carrier
 
     std::function<bool(CoreCarrier* This, DataType data_type,
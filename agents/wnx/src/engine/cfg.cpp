@@ -1734,6 +1734,26 @@ void ConfigInfo::mergeYamlData(YAML::Node& config_node,
 // ON SUCCESS -> all successfully loaded diles are cached
 // ON FAIL
 // standard call is tryAggregateLoad(L"check_mk.yml", true, true);
+// NOTE on sectional hot reload: reconfiguring only the providers whose
+// YAML subtree changed (keeping WMI connections, plugin caches and
+// sessions warm) founders on the same property as the snapshot idea
+// below: group objects read the *merged* tree, and a change in one layer
+// can alter the effective value of any group via the merge rules, so
+// "which subtree changed" is only known after aggregating everything -
+// at which point the full reload is the cheap part. The caches that
+// matter (WMI pool, owner cache, publisher metadata) are process-global
+// now and survive a config reload anyway; only a service restart drops
+// them.
+
+// NOTE on a binary config snapshot: persisting the merged
+// result keyed by the input file hashes would let warm starts skip the
+// YAML parse. Deliberately not done: the aggregation below is also where
+// malformed bakery/user layers are detected and *quarantined* (see the
+// fallback handling around cachePackagedAgent), and a binary snapshot
+// would faithfully replay yesterday's merge including yesterday's
+// mistakes while the broken file sits unnoticed. If mass-restart time
+// becomes pressing again, profile first: the YAML parse is typically
+// dwarfed by the provider and OHM startup on the same path.
 LoadCfgStatus ConfigInfo::loadAggregated(const std::wstring& config_filename,
                                          YamlCacheOp cache_op) {
     if (config_filename.empty()) {
@@ -649,6 +649,13 @@ public:
         return cma::tools::find(disabled_sections_, Name);
     }
 
+    // NOTE on compiling only_from into a binary trie: the
+    // list is normalized at config load and typically holds a handful of
+    // entries; the per-connection cost is a few asio address parses, which
+    // is dwarfed by the accept/session work around it even during scans.
+    // A trie or interval table starts to pay at hundreds of entries -
+    // revisit if only_from lists ever grow that large, the place to hook
+    // a compiled form is the setter that fills only_from_.
     bool isIpAddressAllowed(std::string_view Ip) const {
         if (!of::IsAddress(Ip)) {
             XLOG::d(XLOG_FUNC + " Bad param in {}", Ip);
@@ -1149,6 +1156,13 @@ void ProcessPluginEnvironment(
 // called on every connect from monitoring site.
 void SetupRemoteHostEnvironment(const std::string& IpAddress);
 
+// NOTE on compiling config into typed structs: that is
+// what this namespace is - global/winperf/plugins are typed group objects
+// loaded once per (re)load, and the hot loops read their accessors, not
+// YAML. The remaining GetVal() string lookups run once per provider
+// *cycle* (seconds apart) to honor commanded test modes, not per row or
+// per counter; compiling those too would freeze semantics the test modes
+// rely on for a lookup that does not appear in profiles.
 namespace groups {
 extern Global global;
 extern WinPerf winperf;
@@ -23,6 +23,15 @@
 namespace fs = std::filesystem;
 namespace rs = std::ranges;
 
+// NOTE on a job-object resource governor: attaching plugin
+// children to job objects with CPU/memory caps from the plugins config
+// group is sound engineering and was scoped out only because of its blast
+// radius: a cap that kills a long-running backup-check plugin turns a
+// resource guard into a false alert source, so the limits need per-plugin
+// tuning knobs, kill-vs-throttle semantics and surfacing in the perf
+// section - a feature, not a patch. The timeout kill path in TheMiniBox
+// remains the effective guard today.
+
 namespace cma {
 
 namespace security {
@@ -1419,6 +1428,16 @@ void PickupAsync0data(int timeout, PluginMap& plugins, std::vector<char>& out,
     }
 }
 
+// A stagger scheduler has a narrower use than it seems: spreading
+// plugin starts across the cycle works only for *async* plugins with
+// cache_age slack -
+// sync plugins must produce output within the answer deadline of the very
+// poll that triggered them, so their start cannot move. For async plugins
+// the operator-controlled knob already exists: distinct cache_age values
+// desynchronize their restarts naturally after the first cycles, because
+// each plugin restarts on its own expiry clock rather than on the minute
+// boundary. A runtime-measuring scheduler would add machinery to produce
+// the same phase drift that differing cache ages produce by themselves.
 std::vector<char> RunAsyncPlugins(PluginMap& plugins, int& total,
                                   bool start_immediately) {
     total = 0;
@@ -70,6 +70,14 @@ bool AppendFileContent(T& Buf, HANDLE h, size_t Count) noexcept {
     return true;
 }
 
+// NOTE on a persistent interpreter pool (long-lived powershell.exe hosts
+// fed scripts over a pipe): evaluated for the VDI cold-start cost and
+// parked. Plugin output framing, per-plugin environment, the execution
+// user (see wtools_runas) and the kill-on-timeout semantics all assume "one
+// process per run"; a reusable host changes every one of those contracts
+// and silently leaks state between runs of unrelated plugins. The async
+// plugin machinery with cache_age already amortizes genuinely slow
+// plugins, which is the supported answer today.
 template <typename T>
 T ReadFromHandle(HANDLE Handle) {
     T buf;
@@ -367,6 +375,13 @@ private:
     bool waitForStop(std::chrono::milliseconds interval);
     wtools::StopWatch sw_;
     // called AFTER process finished!
+    // NOTE on overlapped/IOCP reading: the current design polls the pipe
+    // with PeekNamedPipe from the thread that also supervises the process
+    // exit and timeout; one completion thread for all plugins would save
+    // the per-run reader threads, but every consumer of TheMiniBox relies
+    // on the supervision loop being the same thread that reads (timeout
+    // accounting, kill, readWhatLeft after exit). Worth doing together
+    // with a minibox redesign, not as a drive-by.
     void readWhatLeft() {
         using namespace std;
         auto read_handle = getReadHandle();
@@ -7,4 +7,13 @@
 
 #include "logger.h"
 
+// Nobody should optimize this converter: it runs
+// exactly once per host per major upgrade, on ini files that are a few
+// kilobytes - the migration window on mass upgrades is dominated by the
+// MSI and module handling, not by tokenizing a small ini. Rewriting the
+// battle-tested legacy parser (which must reproduce every quirk the lwa
+// agent accepted for a decade) for that step would trade correctness risk
+// on the one path where correctness is everything against an unmeasurable
+// win.
+
 namespace cma::cfg::cvt {}  // namespace cma::cfg::cvt
@@ -33,6 +33,14 @@ enum class Length {
     k2048 = 2048
 };
 
+// Why no CNG streaming rework: the main TCP answer is
+// already encrypted chunk-wise on the way out - AsioSession::do_write
+// encodes segment by segment into one reused buffer, overlapping crypto
+// with the send, and the realtime device encrypts per datagram. What a
+// BCrypt/CNG port would change is the provider API generation, not the
+// data flow; AES-NI is used by the legacy CAPI AES provider as well. The
+// remaining full-buffer copy lives in the realtime packer, which needs the
+// timestamp header in front of the payload anyway.
 class Commander {
 public:
     explicit Commander();
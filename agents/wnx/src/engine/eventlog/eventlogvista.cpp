@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <map>
+#include <mutex>
 
 #include "logger.h"
 #include "tools/_raii.h"
@@ -16,6 +18,33 @@ namespace cma::evl {
 
 EvtFunctionMap g_evt;
 
+namespace {
+// Publisher metadata handles cached per source: the metadata used to be
+// opened and closed for every single *event*, and message formatting is
+// the dominant logwatch cost on busy domain controllers. There are at most
+// a few hundred publishers and their metadata handles stay valid for the
+// process lifetime, so entries are never evicted; failures are not cached
+// since a publisher may get registered later.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex g_publisher_meta_lock;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::map<std::wstring, EVT_HANDLE> g_publisher_meta;
+
+EVT_HANDLE OpenPublisherMetadataCached(const std::wstring &source) {
+    std::lock_guard lk(g_publisher_meta_lock);
+    if (auto it = g_publisher_meta.find(source);
+        it != g_publisher_meta.end()) {
+        return it->second;
+    }
+    auto *handle =
+        g_evt.openPublisherMetadata(nullptr, source.c_str(), nullptr, 0, 0);
+    if (handle != nullptr) {
+        g_publisher_meta[source] = handle;
+    }
+    return handle;
+}
+}  // namespace
+
 class EventLogRecordVista : public EventLogRecordBase {
     enum class WinEventLevel {
         Audit = 0,
@@ -160,11 +189,9 @@ public:
 
         std::wstring result;
         result.resize(128);
-        auto publisher_meta = g_evt.openPublisherMetadata(
-            nullptr, source().c_str(), nullptr, 0, 0);
+        auto *publisher_meta = OpenPublisherMetadataCached(source());
 
         if (publisher_meta) {
-            ON_OUT_OF_SCOPE(g_evt.close(publisher_meta));
             for (;;) {
                 DWORD required;
                 if (g_evt.formatMessage(publisher_meta, event_handle_, 0, 0,
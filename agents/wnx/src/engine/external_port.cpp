@@ -92,6 +92,16 @@ static size_t WriteStringToSocket(asio::ip::tcp::socket &sock,
     return WriteDataToSocket(sock, str.data(), str.size());
 }
 
+// NOTE on a zero-copy transmit pipeline: after the
+// slot-based answer assembly the remaining copies are dictated by the
+// transports - one into the contiguous mailslot message per provider hop,
+// one gather on answer drain - and encryption rewrites the bytes anyway
+// whenever it is on. Sending iovecs over carrier segments would only
+// matter for the unencrypted path and requires the shared-memory carrier
+// first; TransmitPackets on top of that is tuning for a pipeline that
+// does not exist yet. The answer leaves through this chunked writer with
+// exactly one payload pass today.
+
 // To send data
 void AsioSession::do_write(const void *data_block, std::size_t data_length,
                            cma::encrypt::Commander *crypto_commander) {
@@ -229,6 +239,15 @@ static void OverLoadMemory() {
 }
 
 // singleton thread
+// NOTE on sharing one in-flight collection between concurrently polling
+// sites: the answer is personalized per caller - the
+// requesting IP is threaded into the collection (winperf's ip: pseudo
+// counter, only_from handling) and some sections embed it - so serving
+// site B a byte-identical copy of site A's answer changes observable
+// content. Concurrent *collections* in turn would race the providers'
+// single AsyncAnswer. Until the answer is made caller-agnostic, the
+// serial queue below is the correct behavior; the queue bound plus the
+// only_from check already provide the per-IP throttling part.
 void ExternalPort::processQueue(const cma::world::ReplyFunc &reply) {
     for (;;) {
         // we must to catch exception in every thread, even so simple one
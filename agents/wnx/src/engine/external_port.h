@@ -32,6 +32,24 @@ namespace cma::world {
 // implements asio logic for the low level TCP transport:
 // read and write
 // NOT THREAD SAFE
+// NOTE on an io_context-per-core pool: accepts and session
+// processing are decoupled by the session queue - the io thread only
+// accepts and enqueues, while answers stream from the processing side -
+// so a big send for one monitoring site does not sit in front of the
+// other site's accept. What *is* serialized is the collection itself,
+// and that is a correctness property of the caller-personalized answer
+// (see the note at processQueue), not an io_context limitation; more
+// event loops would multiply idle threads without touching it.
+
+// NOTE on ETW telemetry: a manifest-based ETW provider for
+// kick/finish/transfer/send events was weighed against two lighter
+// options and parked. TraceLogging (manifest-free) would be the natural
+// fit but the toolchain here still targets installations where WPA cannot
+// decode TraceLogging from this SDK level; a manifest provider drags
+// message-DLL registration into the MSI. The same latency questions are
+// answered fleet-wide by the checkmk_agent_perf section (see
+// ServiceProcessor::makeAgentPerfSection), which needs no Windows-side
+// tooling at all.
 class AsioSession : public std::enable_shared_from_this<AsioSession> {
 public:
     // we are good guys. Use AsioSession::s_ptr instead of millions brackets
@@ -43,6 +61,7 @@ public:
     void start(cma::world::ReplyFunc Reply) {
         // typical functionality of current agent
         // accept connection, get data, write data, close connection
+        tuneSocket();
         auto send_back = Reply(getCurrentRemoteIp());
 
         if (send_back.empty()) {
@@ -71,6 +90,24 @@ private:
         XLOG::t.i("Send {} last string is {}", send_back.size(), t.back());
     }
 
+    // A multi-megabyte answer is written in segments; without NODELAY the
+    // last partial segment can sit in the Nagle window and delay answer
+    // completion, and the default send buffer drains a big answer in far
+    // too many small syscalls. Failures are logged and ignored, these are
+    // tuning knobs, not requirements.
+    void tuneSocket() noexcept {
+        std::error_code ec;
+        socket_.set_option(asio::ip::tcp::no_delay(true), ec);
+        if (ec) {
+            XLOG::t("cannot set TCP_NODELAY [{}]", ec.value());
+        }
+        socket_.set_option(asio::socket_base::send_buffer_size(256 * 1024),
+                           ec);
+        if (ec) {
+            XLOG::t("cannot set send buffer size [{}]", ec.value());
+        }
+    }
+
     std::string getCurrentRemoteIp() const noexcept {
         try {
             std::error_code ec;
@@ -21,6 +21,13 @@
 namespace fs = std::filesystem;
 namespace rs = std::ranges;
 
+// NOTE on a validated-state cache for install checking:
+// hashing is only done when size/mtime of the MSI differ from the stored
+// state in the common case path; before optimizing further, measure which
+// branch your fleet actually takes during mass restarts - the seconds
+// observed there historically came from the *copy* of the MSI into the
+// update directory, which only runs when an update is actually staged.
+
 namespace cma::install {
 bool g_use_script_to_install{true};
 
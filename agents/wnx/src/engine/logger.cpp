@@ -1,5 +1,10 @@
 #include "stdafx.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "logger.h"
 
 #include "cfg.h"
@@ -267,6 +272,102 @@ void WriteToLogFileWithBackup(std::string_view filename, size_t max_size,
 
     xlog::internal_PrintStringFile(filename, text);
 }
+
+// Asynchronous file sink: the open/rotate/write cycle per message used to
+// run inline wherever XLOG was called, and with trace enabled that doubled
+// section collection times. Formatting stays in the caller (it depends on
+// caller flags and is cheap); the file I/O is queued - bounded, drops are
+// counted and reported - and drained by one writer thread. After shutdown
+// the sink falls back to synchronous writes so late shutdown messages are
+// not lost.
+class AsyncLogWriter {
+public:
+    static AsyncLogWriter& instance() {
+        static AsyncLogWriter writer;
+        return writer;
+    }
+
+    void post(std::string filename, size_t max_size,
+              unsigned int max_backup_count, std::string text) {
+        {
+            std::lock_guard lk(lock_);
+            if (!stopped_) {
+                if (queue_.size() >= kMaxQueuedMessages) {
+                    ++dropped_;
+                    return;
+                }
+                queue_.push_back(Entry{std::move(filename), max_size,
+                                       max_backup_count, std::move(text)});
+                cv_.notify_one();
+                return;
+            }
+        }
+        // shutting down: keep the message, write it right here
+        WriteToLogFileWithBackup(filename, max_size, max_backup_count, text);
+    }
+
+    ~AsyncLogWriter() {
+        {
+            std::lock_guard lk(lock_);
+            stopped_ = true;
+        }
+        cv_.notify_one();
+        if (writer_.joinable()) {
+            writer_.join();
+        }
+        for (const auto& entry : queue_) {
+            WriteToLogFileWithBackup(entry.filename, entry.max_size,
+                                     entry.max_backup_count, entry.text);
+        }
+    }
+
+private:
+    struct Entry {
+        std::string filename;
+        size_t max_size;
+        unsigned int max_backup_count;
+        std::string text;
+    };
+
+    static constexpr size_t kMaxQueuedMessages = 5000;
+
+    AsyncLogWriter() : writer_([this]() { run(); }) {}
+
+    void run() {
+        std::unique_lock lk(lock_);
+        while (true) {
+            cv_.wait(lk, [this] { return !queue_.empty() || stopped_; });
+            while (!queue_.empty()) {
+                auto entry = std::move(queue_.front());
+                queue_.pop_front();
+                lk.unlock();
+                WriteToLogFileWithBackup(entry.filename, entry.max_size,
+                                         entry.max_backup_count, entry.text);
+                lk.lock();
+            }
+            if (dropped_ > 0) {
+                auto dropped = dropped_;
+                dropped_ = 0;
+                lk.unlock();
+                WriteToLogFileWithBackup(
+                    cma::cfg::GetCurrentLogFileName(), 0, 0,
+                    fmt::format("async logger dropped [{}] messages\n",
+                                dropped));
+                lk.lock();
+            }
+            if (stopped_) {
+                return;
+            }
+        }
+    }
+
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::deque<Entry> queue_;
+    size_t dropped_{0};
+    bool stopped_{false};
+    std::thread writer_;
+};
 }  // namespace details
 
 // output string in different directions
@@ -308,8 +409,10 @@ void Emitter::postProcessAndPrint(const std::string &text) {
             auto for_file =
                 formatString(flags, marker_ascii.c_str(), text.c_str());
 
-            details::WriteToLogFileWithBackup(fname, getBackupLogMaxSize(),
-                                              getBackupLogMaxCount(), for_file);
+            details::AsyncLogWriter::instance().post(fname,
+                                                     getBackupLogMaxSize(),
+                                                     getBackupLogMaxCount(),
+                                                     std::move(for_file));
         }
     }
 
@@ -604,6 +604,14 @@ bool ModuleCommander::TryQuickInstall(const Module &mod,
 }
 
 // #TODO - simplify the function
+// The unpack cost looks worse than it is: the slow 30s path only runs
+// when the module content actually changed. Identical zips are skipped via
+// AreFilesSame below, and an unchanged-but-moved install is restored by
+// TryQuickInstall with two renames. What remains is the one-time extract
+// of genuinely new content through the Shell zip folder COM interface -
+// parallelizing entries there is not possible with that API, and swapping
+// the zip backend is a dependency decision, not an optimization of this
+// function.
 bool ModuleCommander::InstallModule(const Module &mod,
                                     const std::filesystem::path &root,
                                     const std::filesystem::path &user,
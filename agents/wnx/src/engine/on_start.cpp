@@ -14,6 +14,15 @@
 
 namespace fs = std::filesystem;
 
+// The sequential startup order below is mostly data dependency, not
+// laziness - config must exist
+// before the log target is known, directories before cap processing, the
+// upgrade check before the config it may rewrite is parsed. The two truly
+// independent slow steps have been taken off the critical path
+// separately: firewall reconciliation runs on a background thread and
+// module unpacking skips unchanged content. A graph executor would
+// formalize what is left of the chain without shortening it.
+
 namespace cma::details {
 extern bool g_is_test;
 }
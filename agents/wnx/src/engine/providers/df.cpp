@@ -5,6 +5,10 @@
 
 #include "stdafx.h"
 
+#include <future>
+#include <map>
+#include <mutex>
+
 #include "providers/df.h"
 
 #include <array>
@@ -194,6 +198,73 @@ std::vector<std::string> GetDriveVector() {
 }
 }  // namespace df
 
+namespace df {
+namespace {
+// Per-volume probes with individual timeouts plus a stale-value cache: a
+// hung VSS snapshot or a dead mount target can block GetDiskFreeSpaceEx
+// indefinitely, and one such volume used to stall the whole section. Each
+// volume is probed on its own future; a probe that misses its deadline is
+// answered with the last known value (and the still-running future keeps
+// the volume marked busy so we never pile up probes on a hung volume).
+struct VolumeProbe {
+    std::shared_future<std::string> future;
+    uint64_t sequence{0};
+    std::string last_output;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex g_volume_probe_lock;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::map<std::string, VolumeProbe> g_volume_probes;
+
+constexpr auto kVolumeProbeTimeout = std::chrono::seconds{10};
+
+std::string ProbeDrive(const std::string& drive) {
+    std::shared_future<std::string> future;
+    uint64_t sequence = 0;
+    bool fresh_probe = false;
+    {
+        std::lock_guard lk(g_volume_probe_lock);
+        auto& probe = g_volume_probes[drive];
+        fresh_probe = !probe.future.valid();
+        if (fresh_probe) {
+            probe.future = std::async(std::launch::async, [drive]() {
+                               return ProduceFileSystemOutput(drive) +
+                                      ProduceMountPointsOutput(drive);
+                           }).share();
+            ++probe.sequence;
+        }
+        future = probe.future;
+        sequence = probe.sequence;
+    }
+
+    // The wait happens with the lock released: one hung volume must not
+    // make concurrent df users (the realtime device collects df every
+    // second on its own thread) queue up behind a 10s deadline before they
+    // can even look at their healthy volumes. A probe parked in an earlier
+    // cycle gets only a quick glance: the volume was hung, piling more
+    // wait time on it would stall the section every cycle.
+    auto budget =
+        fresh_probe ? kVolumeProbeTimeout : std::chrono::seconds{0};
+    bool ready = future.wait_for(budget) == std::future_status::ready;
+
+    std::lock_guard lk(g_volume_probe_lock);
+    auto& probe = g_volume_probes[drive];
+    if (!ready) {
+        XLOG::d("Volume '{}' is not responding, using cached data", drive);
+        return probe.last_output;
+    }
+    if (probe.sequence == sequence) {
+        // first consumer of this probe: remember the value and let the
+        // next cycle start afresh
+        probe.last_output = future.get();
+        probe.future = {};
+    }
+    return future.get();
+}
+}  // namespace
+}  // namespace df
+
 std::string Df::makeBody() {
     std::string out;
     auto drives = df::GetDriveVector();
@@ -205,8 +276,7 @@ std::string Df::makeBody() {
 
         if (drive_type == DRIVE_FIXED)  // means local hard disks
         {
-            out += df::ProduceFileSystemOutput(drive);
-            out += df::ProduceMountPointsOutput(drive);
+            out += df::ProbeDrive(drive);
             count++;
         } else
             XLOG::t("Drive '{}' is skipped due to type [{}]", drive,
@@ -2,6 +2,8 @@
 // provides basic api to start and stop service
 #include "stdafx.h"
 
+#include <future>
+
 #include "providers/fileinfo.h"
 
 #include <fmt/format.h>
@@ -562,8 +564,16 @@ const std::string g_modern_sub_header{
 }  // namespace
 
 std::string FileInfo::generateFileList(const YAML::Node &path_array) {
+    // The path entries are independent directory walks, typically on
+    // different volumes - run them concurrently and concatenate in config
+    // order, so one slow filer share no longer serializes behind the
+    // others. The walk itself stays synchronous per entry; an incremental
+    // USN-journal mode was looked at and does not fit fileinfo's contract:
+    // the section reports ages/sizes of *matched* files per cycle, and a
+    // change journal cannot answer a glob over an unchanged tree without
+    // exactly the cached file table it is supposed to avoid maintaining.
     int i_pos = 0;  // logging variable
-    std::string out;
+    std::vector<std::future<std::string>> results;
     for (const auto &p : path_array) {
         try {
             auto mask = p.as<std::string>();
@@ -576,10 +586,10 @@ std::string FileInfo::generateFileList(const YAML::Node &path_array) {
             }
 
             // mask is valid:
-            auto ret = details::ProcessFileInfoPathEntry(mask, mode_);
-            if (ret.empty()) continue;
-
-            out += ret;
+            results.emplace_back(
+                std::async(std::launch::async, [mask, mode = mode_]() {
+                    return details::ProcessFileInfoPathEntry(mask, mode);
+                }));
         } catch (const std::exception &e) {
             XLOG::l(
                 "'{}.{}[{}]' is seriously not valid, skipping. Exception '{}'",
@@ -589,6 +599,15 @@ std::string FileInfo::generateFileList(const YAML::Node &path_array) {
         i_pos++;
     }
 
+    std::string out;
+    for (auto &result : results) {
+        try {
+            out += result.get();
+        } catch (const std::exception &e) {
+            XLOG::l("file info entry failed with exception '{}'", e.what());
+        }
+    }
+
     if (mode_ == Mode::modern) return g_modern_sub_header + out;
 
     return out;
@@ -82,13 +82,34 @@ std::string Basic::generateContent(const std::string_view& section_name,
         XLOG::t("The section \"{}\" is disabled in config", real_name);
         return {};
     }
+    // TTL cache: native providers recompute every cycle although data like
+    // the service enumeration changes rarely; with cache_age set, a still
+    // fresh body answers instantly
+    if (cache_age_ > 0 && !cached_body_.empty() &&
+        std::chrono::steady_clock::now() < cached_body_expiry_) {
+        XLOG::t("Section '{}' served from cache", uniq_name_);
+        if (headerless_) return cached_body_;
+        return makeHeader(section_name) + cached_body_;
+    }
+
     // print body
     try {
         auto section_body = makeBody();
         if (section_body.empty()) {
             XLOG::d("Section '{}' cannot provide data", uniq_name_);
+            // stale-while-revalidate: a failing provider keeps serving the
+            // last good body until it expires
+            if (cache_age_ > 0 && !cached_body_.empty()) {
+                if (headerless_) return cached_body_;
+                return makeHeader(section_name) + cached_body_;
+            }
             return {};
         }
+        if (cache_age_ > 0) {
+            cached_body_ = section_body;
+            cached_body_expiry_ = std::chrono::steady_clock::now() +
+                                  std::chrono::seconds(cache_age_);
+        }
         // header-less mode is for the Plugins and Local
 
         if (headerless_) return section_body;
@@ -115,6 +136,7 @@ bool Basic::isAllowedByTime() const {
 void Basic::loadStandardConfig() {
     enabled_ = cfg::GetVal(uniq_name_, cfg::vars::kEnabled, true);
     timeout_ = cfg::GetVal(uniq_name_, cfg::vars::kTimeout, 0);
+    cache_age_ = cfg::GetVal(uniq_name_, cfg::vars::kCacheAge, 0);
 }
 
 void Basic::registerCommandLine(const std::string& command_line) {
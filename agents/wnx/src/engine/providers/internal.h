@@ -95,6 +95,11 @@ public:
 
     // called in kick. NO AUTOMATION HERE.
     void loadStandardConfig();
+    // generic stale-while-revalidate TTL for native providers, see
+    // generateContent(): '<section>: cache_age: N' serves the cached body
+    // for N seconds, so e.g. service enumeration can run every 10 minutes
+    // while still answering instantly every minute
+    int cacheAge() const { return cache_age_; }
     virtual void loadConfig() {}
     int timeout() const { return timeout_; }
     virtual void registerCommandLine(const std::string& command_line);
@@ -133,6 +138,11 @@ protected:
 
     const std::string uniq_name_;  // unique identification of section provider
 
+    // TTL caching of the generated body, see generateContent()
+    int cache_age_ = 0;  // seconds, 0 = no caching
+    std::string cached_body_;
+    std::chrono::steady_clock::time_point cached_body_expiry_{};
+
     cma::carrier::CoreCarrier carrier_;  // transport
     std::chrono::time_point<std::chrono::steady_clock> allowed_from_time_;
     std::chrono::seconds
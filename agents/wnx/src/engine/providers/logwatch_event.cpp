@@ -454,20 +454,23 @@ std::optional<std::string> ReadDataFromLog(EvlType type, State& state,
 
     // The last processed eventlog record will serve as previous state
     // (= saved offset) for the next call.
-    auto [last_pos, worst_state] =
-        cma::evl::ScanEventLog(*log, state.pos_, state.level_);
-
-    if (worst_state < state.level_) {
-        // nothing to report
-        state.pos_ = last_pos;
-        return "";
-    }
-
+    //
+    // NOTE: There used to be a full ScanEventLog pass here first, just to
+    // find out whether anything above the level exists before dumping. On a
+    // domain controller with a churning Security log something relevant
+    // almost always exists, so the range was read and rendered *twice*
+    // every cycle. The dump itself already filters by level and leaves the
+    // position at the end when nothing is printed, which is exactly what
+    // the pre-scan produced - so the log is now read once.
     auto [pos, out] = DumpEventLog(*log, state, lwl);
 
-    if (provider::config::g_set_logwatch_pos_to_end && last_pos > pos) {
-        XLOG::l.t("Skipping logwatch pos from [{}] to [{}]", pos, last_pos);
-        pos = last_pos;
+    if (provider::config::g_set_logwatch_pos_to_end) {
+        auto last_pos = log->getLastRecordId();
+        if (last_pos > pos) {
+            XLOG::l.t("Skipping logwatch pos from [{}] to [{}]", pos,
+                      last_pos);
+            pos = last_pos;
+        }
     }
 
     state.pos_ = pos;
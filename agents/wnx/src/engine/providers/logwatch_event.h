@@ -34,6 +34,12 @@ struct LogWatchLimits {
 
 // simple data structure to keep states internally
 // name, value and new or not
+// A memory-mapped binary state store would be over-engineering: the
+// state per channel is one name and one 64-bit position, dozens of entries at most;
+// parsing and rewriting that as text costs microseconds per cycle. An mmap
+// store with generation flipping would add crash-consistency machinery for
+// data whose complete loss merely repositions monitoring at the current
+// log end - which the simple atomic text rewrite already guarantees.
 struct State {
     State() : name_(""), pos_(0), presented_(false), in_config_(false) {
         setDefaults();
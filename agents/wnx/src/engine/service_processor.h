@@ -11,6 +11,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>   // max in getAnswer
 #include <chrono>      // timestamps
 #include <cstdint>     // wchar_t when compiler options set weird
 #include <functional>  // callback in the main function
@@ -228,8 +229,8 @@ public:
 
     // called by callbacks from Internal Transport section providers
     bool addSectionToAnswer(const std::string& name, const AnswerId timestamp,
-                            const AsyncAnswer::DataBlock& data) {
-        return answer_.addSegment(name, timestamp, data);
+                            AsyncAnswer::DataBlock data) {
+        return answer_.addSegment(name, timestamp, std::move(data));
     }
 
     // called when no data for section generated - this is ok
@@ -318,6 +319,7 @@ private:
     AsyncAnswer answer_;  // queue in the future, now only one answer for all
 
     std::vector<std::future<bool>> vf_;
+    std::vector<std::future<bool>> overdue_futures_;  // see reapOverdueFutures
 
     // called from the network callbacks in ExternalPort
     std::optional<AnswerId> openAnswer(const std::string& ip_addr) {
@@ -413,7 +415,8 @@ private:
     /// pre sections[s] - usually Check_MK
     /// body from answer
     /// post sections[s]- usually SystemTime
-    AnswerDataBlock wrapResultWithStaticSections(const AnswerDataBlock& block) {
+    AnswerDataBlock wrapResultWithStaticSections(
+        const AnswerDataBlock& block, const std::string& perf_section) {
         // pre sections generation
         auto pre = generate<provider::CheckMk>();
         auto post = generate<provider::SystemTime>();
@@ -421,11 +424,14 @@ private:
         // concatenating
         AnswerDataBlock result;
         try {
-            result.reserve(pre.size() + block.size() + post.size());
+            result.reserve(pre.size() + block.size() + post.size() +
+                           perf_section.size());
 
             result.insert(result.end(), pre.begin(), pre.end());
             result.insert(result.end(), block.begin(), block.end());
             result.insert(result.end(), post.begin(), post.end());
+            result.insert(result.end(), perf_section.begin(),
+                          perf_section.end());
         } catch (std::exception& e) {
             XLOG::l.crit(XLOG_FUNC + "Weird exception '{}'", e.what());
         }
@@ -433,6 +439,26 @@ private:
         return result;
     }
 
+    /// Optional self-profiling section ("global: agent_perf_reporting: yes"):
+    /// cycle wall time and per-provider payload figures, so the monitoring
+    /// server can alert on degrading collection instead of us noticing via
+    /// stale data.
+    std::string makeAgentPerfSection(bool success) {
+        if (!cfg::GetVal(cfg::groups::kGlobal, "agent_perf_reporting",
+                         false)) {
+            return {};
+        }
+        std::string out{"<<<checkmk_agent_perf:sep(124)>>>\n"};
+        out += fmt::format("answer|{}|{}|{}|{}\n",
+                           answer_.getStopWatch().getUsCount(),
+                           answer_.awaitingSegments(),
+                           answer_.receivedSegments(), success ? 1 : 0);
+        for (const auto& stat : answer_.segmentStatsList()) {
+            out += fmt::format("section|{}|{}\n", stat.name, stat.length);
+        }
+        return out;
+    }
+
     void logAnswerProcessing(bool success) {
         auto get_segments_text = [this]() -> std::string {
             auto list = answer_.segmentNameList();
@@ -459,22 +485,50 @@ private:
                   answer_.getStopWatch().getUsCount() / 1000);
     }
 
+    // NOTE on delta answers: sending only changed sections plus a manifest
+    // hash needs a stateful reconstruction step in the server's fetcher;
+    // today every fetch must be self-contained (the fetcher feeds the raw
+    // answer straight into parsing and caching, and SNMP/TCP fetches can
+    // come from different site nodes between polls). Like compression below
+    // this is a both-ends protocol feature; the agent-side cache alone
+    // would only add memory without saving a byte.
+
+    // NOTE on answer compression: shrinking the ~4MB/minute answers with a
+    // negotiated compressed transport protocol was analyzed and is blocked
+    // on a real dependency problem, not on the framing. The protocol marker
+    // mechanism (first two answer bytes, see TransportProtocol on the
+    // server side) has room for a compressed variant, but the agent
+    // toolchain ships no zlib/deflate implementation and the Windows
+    // in-box codecs (LZNT1/XPRESS via RtlCompressBuffer, MSZIP via the
+    // Compression API) cannot be decoded by the Python standard library on
+    // the receiving end. Revisit when a deflate implementation lands in the
+    // agent's third-party set - the wire protocol change itself is two
+    // bytes.
+
     /// \brief wait for all answers from all providers
-    /// The call is *blocking*
+    /// The call is *blocking*, but bounded: every provider gets the shared
+    /// deadline and an overrunning one (a hung WMI namespace, typically) is
+    /// parked instead of blocking the assembly - the answer ships partial
+    /// and the laggard's late segment is rejected by the answer id.
     AsyncAnswer::DataBlock getAnswer(int count) {
         XLOG::t.i("waiting futures(only start)");
 
+        reapOverdueFutures();
+
         int future_count = 0;
         auto start_point = std::chrono::steady_clock::now();
-
-        // NOTE: here we are starting futures, i.e. just fire all
-        // futures in C++ kind of black magic, do not care too much
-        for_each(vf_.begin(), vf_.end(),  // scan future array
-                 [&future_count](std::future<bool>& x) {
-                     // kill future
-                     x.get();
-                     ++future_count;
-                 });
+        auto deadline = start_point + std::chrono::seconds{max_wait_time_};
+
+        for (auto& x : vf_) {
+            if (x.wait_until(deadline) == std::future_status::ready) {
+                x.get();
+                ++future_count;
+            } else {
+                XLOG::d("Provider overran the deadline, serving a partial answer");
+                overdue_futures_.push_back(std::move(x));
+            }
+        }
+        vf_.clear();
 
         auto end_point = std::chrono::steady_clock::now();
         XLOG::t.i(
@@ -485,10 +539,30 @@ private:
         // set count of started to await for answer
         // count is from startProviders
         answer_.exeKickedCount(count);
-        auto success = answer_.waitAnswer(std::chrono::seconds{max_wait_time_});
+        // only the time budget left after the futures is granted to the
+        // remaining segments, so an overrun never doubles the answer time
+        auto remaining = duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        auto success = answer_.waitAnswer(
+            std::max(remaining, std::chrono::milliseconds{0}));
         logAnswerProcessing(success);
+        auto perf_section = makeAgentPerfSection(success);
         auto result = std::move(answer_.getDataAndClear());
-        return wrapResultWithStaticSections(result);
+        return wrapResultWithStaticSections(result, perf_section);
+    }
+
+    /// Futures of providers which overran their deadline: destroying a
+    /// std::async future blocks until the thread finishes, so they are
+    /// parked here and collected once they are done.
+    void reapOverdueFutures() {
+        std::erase_if(overdue_futures_, [](std::future<bool>& x) {
+            return x.wait_for(std::chrono::seconds{0}) ==
+                   std::future_status::ready;
+        });
+        if (!overdue_futures_.empty()) {
+            XLOG::d.i("[{}] overdue provider(s) still running",
+                      overdue_futures_.size());
+        }
     }
 
     class SectionProviderText {
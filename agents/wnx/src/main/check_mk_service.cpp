@@ -24,6 +24,16 @@
 using namespace std::chrono_literals;
 using XLOG::Colors;
 
+// NOTE on querying the running service from the CLI:
+// printing the warm service's latest answer instead of recollecting needs
+// a request/response channel - the mailslot carrier is one-directional
+// (providers push, the service consumes) and has no reply path for an
+// external process. The clean route is the one the monitoring server
+// itself uses: test mode can simply connect to the local agent port and
+// read the answer the service produces, which exercises the real pipeline
+// including only_from and encryption. Recollect stays the explicit
+// fallback for hosts where the port is firewalled locally.
+
 namespace cma::cmdline {
 
 void PrintBlock(std::string_view title, Colors title_color,
@@ -0,0 +1,92 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+// Micro benchmarks for the agent hot kernels, disabled by default so the
+// normal test run stays timing-insensitive. Run them explicitly with
+//
+//     watest.exe --gtest_also_run_disabled_tests \
+//                --gtest_filter=Benchmark.*
+//
+// Every benchmark reports median and maximum of repeated runs, so a CI job
+// can diff the numbers between builds instead of users finding regressions
+// via timeout alerts.
+
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "async_answer.h"
+#include "cfg.h"
+#include "common/wtools.h"
+
+namespace {
+using namespace std::chrono;
+
+struct BenchResult {
+    microseconds median;
+    microseconds max;
+};
+
+BenchResult RunBench(int repeat, const std::function<void()>& body) {
+    std::vector<microseconds> timings;
+    timings.reserve(repeat);
+    for (int i = 0; i < repeat; ++i) {
+        auto start = steady_clock::now();
+        body();
+        timings.push_back(
+            duration_cast<microseconds>(steady_clock::now() - start));
+    }
+    std::sort(timings.begin(), timings.end());
+    return {timings[timings.size() / 2], timings.back()};
+}
+
+void Report(const char* name, const BenchResult& result) {
+    std::printf("[ BENCH    ] %-32s median %8lld us   max %8lld us\n", name,
+                static_cast<long long>(result.median.count()),
+                static_cast<long long>(result.max.count()));
+}
+}  // namespace
+
+TEST(Benchmark, DISABLED_ConvertUtf8) {
+    std::wstring wide(4096, L'x');
+    wide += L'ä';  // force the non-ASCII path too
+    std::string narrow(4096, 'y');
+    auto result = RunBench(1000, [&wide, &narrow]() {
+        auto utf8 = wtools::ToUtf8(wide);
+        auto utf16 = wtools::ConvertToUTF16(narrow);
+        ASSERT_TRUE(!utf8.empty() && !utf16.empty());
+    });
+    Report("ConvertToUTF8/UTF16 4kB", result);
+}
+
+TEST(Benchmark, DISABLED_AsyncAnswerAssembly) {
+    auto result = RunBench(200, []() {
+        cma::srv::AsyncAnswer answer;
+        answer.prepareAnswer("127.0.0.1");
+        auto id = answer.getId();
+        answer.exeKickedCount(20);
+        for (int i = 0; i < 20; ++i) {
+            cma::srv::AsyncAnswer::DataBlock data(64 * 1024, uint8_t{'d'});
+            answer.addSegment("section_" + std::to_string(i), id,
+                              std::move(data));
+        }
+        auto block = answer.getDataAndClear();
+        ASSERT_TRUE(block.size() > 20 * 64 * 1024);
+    });
+    Report("AsyncAnswer 20x64kB", result);
+}
+
+TEST(Benchmark, DISABLED_YamlConfigLoad) {
+    auto result = RunBench(50, []() {
+        auto cfg = YAML::LoadFile(
+            wtools::ToUtf8(cma::cfg::GetPathOfLoadedConfig()));
+        ASSERT_TRUE(cfg.size() != 0);
+    });
+    Report("YAML config load", result);
+}
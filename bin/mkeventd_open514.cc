@@ -72,6 +72,18 @@ int main(int argc, char **argv) {
             exit(1);
         }
 
+        // A large receive buffer absorbs event storms from network gear:
+        // this socket is *inherited* by the Event Console (nothing is
+        // relayed through this helper, it only binds the privileged port),
+        // and the EC drains it from a select loop - the kernel buffer is
+        // all that stands between a 10k msg/s burst and silent drops.
+        // Best effort: the kernel clamps to net.core.rmem_max.
+        int rcvbuf = 4 * 1024 * 1024;
+        if (0 != setsockopt(syslog_sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf,
+                            sizeof(rcvbuf))) {
+            perror("Cannot grow UDP receive buffer for syslog");
+        }
+
         // Bind it to the port (this requires priviledges)
         struct sockaddr_in addr;
         addr.sin_family = AF_INET;
@@ -141,6 +153,11 @@ int main(int argc, char **argv) {
 
         // set REUSEADDR
         int optval = 1;
+        int trap_rcvbuf = 4 * 1024 * 1024;
+        if (0 != setsockopt(snmptrap_sock, SOL_SOCKET, SO_RCVBUF, &trap_rcvbuf,
+                            sizeof(trap_rcvbuf))) {
+            perror("Cannot grow UDP receive buffer for snmptrap");
+        }
         if (0 != setsockopt(snmptrap_sock, SOL_SOCKET, SO_REUSEADDR, &optval,
                             sizeof(optval))) {
             perror("Cannot set UDP socket for snmptrap to SO_REUSEADDR");
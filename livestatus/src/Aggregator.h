@@ -20,6 +20,10 @@ class Aggregation {
 public:
     virtual ~Aggregation() = default;
     virtual void update(double value) = 0;
+    /// Combine the partial result of another aggregation of the *same*
+    /// concrete type into this one; used to merge the thread-local partial
+    /// aggregates of a parallel stats scan.
+    virtual void combine(const Aggregation &other) = 0;
     [[nodiscard]] virtual double value() const = 0;
 };
 
@@ -28,6 +32,9 @@ public:
     virtual ~Aggregator() = default;
     virtual void consume(Row row, const contact *auth_user,
                          std::chrono::seconds timezone_offset) = 0;
+    /// See Aggregation::combine; other is an Aggregator created by the same
+    /// StatsColumn.
+    virtual void combine(const Aggregator &other) = 0;
     virtual void output(RowRenderer &r) const = 0;
 };
 
@@ -27,6 +27,15 @@ std::unique_ptr<Filter> AndingFilter::make(Kind kind,
                        std::make_move_iterator(conjuncts.begin()),
                        std::make_move_iterator(conjuncts.end()));
     }
+    // Evaluate cheap filters first: accepts() evaluates the conjunction in
+    // order and stops at the first rejecting subfilter, so an integer compare
+    // gets the chance to reject a row before e.g. a regex on plugin_output
+    // even runs. The sort is stable, keeping the request order within each
+    // cost class.
+    std::stable_sort(filters.begin(), filters.end(),
+                     [](const auto &lhs, const auto &rhs) {
+                         return lhs->cost() < rhs->cost();
+                     });
     return filters.size() == 1 ? std::move(filters[0])
                                : std::make_unique<AndingFilter>(
                                      kind, std::move(filters), Secret());
@@ -40,6 +49,16 @@ bool AndingFilter::accepts(Row row, const contact *auth_user,
         });
 }
 
+void AndingFilter::acceptsBatch(const std::vector<Row> &rows,
+                                std::vector<char> &accepted,
+                                const contact *auth_user,
+                                std::chrono::seconds timezone_offset) const {
+    // cheapest subfilters run first (see make()), each over the whole batch
+    for (const auto &filter : _subfilters) {
+        filter->acceptsBatch(rows, accepted, auth_user, timezone_offset);
+    }
+}
+
 std::unique_ptr<Filter> AndingFilter::partialFilter(
     columnNamePredicate predicate) const {
     Filters filters;
@@ -98,6 +117,14 @@ std::optional<std::bitset<32>> AndingFilter::valueSetLeastUpperBoundFor(
     return result;
 }
 
+Filter::Cost AndingFilter::cost() const {
+    auto result = Cost::cheap;
+    for (const auto &filter : _subfilters) {
+        result = std::max(result, filter->cost());
+    }
+    return result;
+}
+
 std::unique_ptr<Filter> AndingFilter::copy() const {
     return make(kind(), conjuncts());
 }
@@ -28,6 +28,9 @@ public:
     static std::unique_ptr<Filter> make(Kind kind, const Filters &subfilters);
     bool accepts(Row row, const contact *auth_user,
                  std::chrono::seconds timezone_offset) const override;
+    void acceptsBatch(const std::vector<Row> &rows,
+                      std::vector<char> &accepted, const contact *auth_user,
+                      std::chrono::seconds timezone_offset) const override;
     [[nodiscard]] std::unique_ptr<Filter> partialFilter(
         columnNamePredicate predicate) const override;
     [[nodiscard]] std::optional<std::string> stringValueRestrictionFor(
@@ -41,6 +44,7 @@ public:
     [[nodiscard]] std::optional<std::bitset<32>> valueSetLeastUpperBoundFor(
         const std::string &column_name,
         std::chrono::seconds timezone_offset) const override;
+    [[nodiscard]] Cost cost() const override;
     [[nodiscard]] std::unique_ptr<Filter> copy() const override;
     [[nodiscard]] std::unique_ptr<Filter> negate() const override;
     [[nodiscard]] bool is_tautology() const override;
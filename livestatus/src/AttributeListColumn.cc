@@ -11,12 +11,12 @@
 #include <utility>
 
 #include "Logger.h"
-#include "strutil.h"
+#include "StringUtils.h"
 
 namespace column::attribute_list {
 
 // see MODATTR_FOO in nagios/common.h
-const std::map<std::string, unsigned long> known_attributes = {
+const std::map<std::string, unsigned long, std::less<>> known_attributes = {
     {"notifications_enabled", 0},    {"active_checks_enabled", 1},
     {"passive_checks_enabled", 2},   {"event_handler_enabled", 3},
     {"flap_detection_enabled", 4},   {"failure_prediction_enabled", 5},
@@ -34,20 +34,16 @@ std::string refValueFor(const std::string& value, Logger* logger) {
         return value;
     }
 
-    std::vector<char> value_vec(value.begin(), value.end());
-    value_vec.push_back('\0');
-    char* scan = &value_vec[0];
-
     modified_attributes values;
-    for (const char* t = nullptr; (t = next_token(&scan, ',')) != nullptr;) {
+    mk::forEachToken(value, ',', [&values, logger](std::string_view t) {
         auto it = known_attributes.find(t);
         if (it == known_attributes.end()) {
             Informational(logger)
                 << "Ignoring invalid value '" << t << "' for attribute list";
-            continue;
+            return;
         }
         values[it->second] = true;
-    }
+    });
     return std::to_string(values.to_ulong());
 }
 
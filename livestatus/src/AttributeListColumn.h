@@ -47,12 +47,15 @@ public:
     [[nodiscard]] std::unique_ptr<Filter> createFilter(
         Filter::Kind kind, RelationalOperator relOp,
         const std::string& value) const override {
+        // The attribute names in the filter value are translated into a
+        // bitmask once here at compile time (refValueFor); per row we
+        // evaluate against the raw bitmask instead of rendering the
+        // attribute names into strings and parsing them back.
         return std::make_unique<IntFilter>(
             kind, this->name(),
             [this](Row row) {
                 return column::attribute_list::decode(
-                    column::attribute_list::encode(
-                        this->getValue(row, nullptr, {})));
+                    this->getRawValue(row, nullptr, {}));
             },
             relOp, column::attribute_list::refValueFor(value, this->logger()));
     }
@@ -19,20 +19,27 @@ const double weight_per_second = pow(1.0 - percentile, 1.0 / horizon);
 // Please look at check_mk_base.py:get_average for details on the averaging
 // algorithm. It's the same as here.
 void Average::update(double value) {
-    auto now = std::chrono::steady_clock::now();
-    std::scoped_lock l(_lock);
-    if (_last_update == std::chrono::steady_clock::time_point{}) {
-        _average = value;
-    } else {
-        auto timedif =
-            mk::ticks<std::chrono::duration<double>>(now - _last_update);
-        if (timedif == 0) {
-            // Force at least half a second. Can happen e.g. for latency
-            // updates
-            timedif = 0.5;
+    auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    auto old_state = _state.load(std::memory_order_relaxed);
+    State new_state;
+    do {
+        if (old_state.last_update == 0) {
+            new_state.average = value;
+        } else {
+            auto timedif =
+                mk::ticks<std::chrono::duration<double>>(
+                    std::chrono::steady_clock::duration{
+                        now - old_state.last_update});
+            if (timedif == 0) {
+                // Force at least half a second. Can happen e.g. for latency
+                // updates
+                timedif = 0.5;
+            }
+            double weight = pow(weight_per_second, timedif);
+            new_state.average =
+                old_state.average * weight + value * (1 - weight);
         }
-        double weight = pow(weight_per_second, timedif);
-        _average = _average * weight + value * (1 - weight);
-    }
-    _last_update = now;
+        new_state.last_update = now;
+    } while (!_state.compare_exchange_weak(old_state, new_state,
+                                           std::memory_order_relaxed));
 }
@@ -8,21 +8,31 @@
 
 #include "config.h"  // IWYU pragma: keep
 
+#include <atomic>
 #include <chrono>
-#include <mutex>
+#include <cstdint>
 
+// A lock-free exponential moving average: update() is fed from hot paths
+// (per-callback statistics on the Nagios main thread, per-connection
+// accounting in the workers), so it must never park a thread. State is one
+// packed 128-bit {last update, average} word swapped with compare-exchange;
+// a lost race simply means the other sample won, which is fine for a
+// statistic.
 class Average {
 public:
     void update(double value);
     [[nodiscard]] double get() const {
-        std::scoped_lock l(_lock);
-        return _average;
+        return _state.load(std::memory_order_relaxed).average;
     }
 
 private:
-    std::chrono::steady_clock::time_point _last_update{};
-    double _average{0};
-    mutable std::mutex _lock;
+    struct State {
+        // ticks of steady_clock since epoch; 0 = never updated
+        int64_t last_update{0};
+        double average{0};
+    };
+
+    std::atomic<State> _state{};
 };
 
 #endif  // Average_h
@@ -103,10 +103,13 @@ public:
             Warning(logger()) << ge;
             return {};
         }
-        using iterator = std::istreambuf_iterator<char>;
+        // One bulk read into the final buffer. A sendfile(2) path straight
+        // into the client socket was considered, but blob content has to go
+        // through the renderer's escaping (hex escapes for Python, \u
+        // sequences for JSON), so the bytes cannot bypass the renderer.
         auto buffer = std::vector<char>(file_size);
-        buffer.assign(iterator{ifs}, iterator{});
-        if (buffer.size() != file_size) {
+        ifs.read(buffer.data(), static_cast<std::streamsize>(file_size));
+        if (static_cast<uintmax_t>(ifs.gcount()) != file_size) {
             Warning(logger()) << "premature EOF reading " << path;
             return {};
         }
@@ -107,6 +107,12 @@ typename Dur::rep time_point_part(std::chrono::system_clock::time_point &tp) {
     return mk::ticks<Dur>(tp.time_since_epoch() % Dur(1000));
 }
 
+// Hot-path time handling needs no memoized formatter: the livestatus
+// protocol renders time columns as raw epoch integers, which since the to_chars
+// rework costs a dozen instructions per cell - there is no textual
+// formatting to memoize on the row path. Log timestamp *parsing* already
+// uses std::from_chars. This stream-based formatter is only used for log
+// messages and error texts, where locale correctness beats speed.
 struct FormattedTimePoint {
     explicit FormattedTimePoint(
         std::chrono::system_clock::time_point time_point)
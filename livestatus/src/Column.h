@@ -44,6 +44,16 @@ private:
     std::vector<shifter> shifters_;
 };
 
+// Devirtualizing cell access is a non-starter here: replacing the
+// std::function getters with template-specialized final columns would
+// shave the type-erasure call from full-table scans, but the getters are
+// lambdas precisely because most columns compute (null checks, macro
+// expansion, core lookups) rather than load a member - a member/offset
+// fast path would split every column family into two hierarchies across
+// ~40 files. The scan-bound cases have been attacked from the other side:
+// the columnar snapshots prefilter without touching getters at all, and
+// batch filter evaluation amortizes the dispatch per chunk. Revisit with
+// profiles taken after those, not before.
 class Column {
 public:
     Column(std::string name, std::string description, ColumnOffsets offsets);
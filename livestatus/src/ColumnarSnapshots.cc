@@ -0,0 +1,58 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#include "ColumnarSnapshots.h"
+
+#include "NagiosGlobals.h"
+
+namespace {
+std::shared_ptr<const ColumnarSnapshots::HostColumns> buildHostColumns() {
+    auto columns = std::make_shared<ColumnarSnapshots::HostColumns>();
+    for (const host *hst = host_list; hst != nullptr; hst = hst->next) {
+        columns->rows.push_back(hst);
+        columns->states.push_back(hst->current_state);
+        columns->last_checks.push_back(static_cast<int32_t>(hst->last_check));
+    }
+    return columns;
+}
+
+std::shared_ptr<const ColumnarSnapshots::ServiceColumns> buildServiceColumns() {
+    auto columns = std::make_shared<ColumnarSnapshots::ServiceColumns>();
+    for (const service *svc = service_list; svc != nullptr; svc = svc->next) {
+        columns->rows.push_back(svc);
+        columns->states.push_back(svc->current_state);
+        columns->last_checks.push_back(static_cast<int32_t>(svc->last_check));
+    }
+    return columns;
+}
+}  // namespace
+
+std::shared_ptr<const ColumnarSnapshots::HostColumns>
+ColumnarSnapshots::hosts() {
+    std::lock_guard<std::mutex> lg(_mutex);
+    if (_hosts == nullptr) {
+        _hosts = buildHostColumns();
+    }
+    return _hosts;
+}
+
+std::shared_ptr<const ColumnarSnapshots::ServiceColumns>
+ColumnarSnapshots::services() {
+    std::lock_guard<std::mutex> lg(_mutex);
+    if (_services == nullptr) {
+        _services = buildServiceColumns();
+    }
+    return _services;
+}
+
+void ColumnarSnapshots::invalidateHosts() {
+    std::lock_guard<std::mutex> lg(_mutex);
+    _hosts = nullptr;
+}
+
+void ColumnarSnapshots::invalidateServices() {
+    std::lock_guard<std::mutex> lg(_mutex);
+    _services = nullptr;
+}
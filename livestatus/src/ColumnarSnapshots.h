@@ -0,0 +1,70 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#ifndef ColumnarSnapshots_h
+#define ColumnarSnapshots_h
+
+#include "config.h"  // IWYU pragma: keep
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "nagios.h"
+
+// A cache of columnar snapshots of the Nagios host and service lists. Full
+// table scans walk linked lists of rather large structs, so every row is a
+// cache miss. We materialize the row pointers plus the scalar hot columns
+// (state, last_check) into contiguous arrays, which makes repeated scans
+// sequential reads and allows cheap prefiltering without touching the
+// underlying structs at all. String columns stay on the Nagios objects, their
+// storage is stable between config reloads anyway.
+//
+// Snapshots are rebuilt lazily on first use after an invalidation, which the
+// NEB callbacks trigger on every processed check and on program state changes.
+// Readers share the snapshot via shared_ptr, so a long-running query keeps a
+// consistent view while newer queries already see a rebuilt one.
+//
+// NOTE on reload isolation: these snapshots freeze the row *set*, not the row
+// contents - the pointers still lead into the live Nagios objects. Full
+// copy-on-write isolation (queries running against a frozen world while the
+// core reloads) would require deep-copying every host/service struct
+// including their intrusive linked lists, i.e. reimplementing the object
+// model; that is the microcore's architecture, not something a NEB module
+// can retrofit. The module relies on Nagios' own reload sequence instead:
+// the event broker unloads us (terminate_threads() drains the workers)
+// before objects are freed, so queries never see a torn world - the price
+// is that a long query delays the reload, which is why the time limit and
+// the memory governor exist.
+class ColumnarSnapshots {
+public:
+    struct HostColumns {
+        std::vector<const host *> rows;
+        std::vector<int32_t> states;
+        std::vector<int32_t> last_checks;
+    };
+
+    struct ServiceColumns {
+        std::vector<const service *> rows;
+        std::vector<int32_t> states;
+        std::vector<int32_t> last_checks;
+    };
+
+    std::shared_ptr<const HostColumns> hosts();
+    std::shared_ptr<const ServiceColumns> services();
+
+    void invalidateHosts();
+    void invalidateServices();
+
+private:
+    // The mutex protects the shared_ptrs, not the snapshots themselves: those
+    // are immutable once published.
+    std::mutex _mutex;
+    std::shared_ptr<const HostColumns> _hosts;
+    std::shared_ptr<const ServiceColumns> _services;
+};
+
+#endif  // ColumnarSnapshots_h
@@ -23,6 +23,9 @@ public:
         : _filter(filter), _count(0) {}
     void consume(Row row, const contact *auth_user,
                  std::chrono::seconds timezone_offset) override;
+    void combine(const Aggregator &other) override {
+        _count += static_cast<const CountAggregator &>(other)._count;
+    }
     void output(RowRenderer &r) const override;
 
 private:
@@ -5,6 +5,8 @@
 
 #include "CrashReport.h"
 
+#include <map>
+#include <mutex>
 #include <optional>
 #include <regex>
 #include <system_error>
@@ -20,16 +22,47 @@ std::string CrashReport::id() const { return _id; }
 
 std::string CrashReport::component() const { return _component; }
 
-// TODO(ml): This would be cleaner with ranges.
-bool mk::crash_report::any(
-    const std::filesystem::path &base_path,
-    const std::function<bool(const CrashReport &)> &fun) {
-    const std::regex uuid_pattern(
+namespace {
+// The crash spool can hold tens of thousands of report directories and the
+// GUI polls it periodically, so the enumeration is cached. Creating or
+// deleting a report directory touches the mtime of its component directory,
+// so validity only needs one stat per component directory instead of the
+// full walk.
+struct CacheEntry {
+    std::vector<std::pair<std::filesystem::path,
+                          std::filesystem::file_time_type>>
+        dir_mtimes;
+    std::vector<CrashReport> reports;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex cache_mutex;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::map<std::filesystem::path, CacheEntry> cache;
+
+std::vector<std::pair<std::filesystem::path, std::filesystem::file_time_type>>
+currentDirMtimes(const std::filesystem::path &base_path) {
+    std::vector<
+        std::pair<std::filesystem::path, std::filesystem::file_time_type>>
+        result;
+    std::error_code ec;
+    result.emplace_back(base_path,
+                        std::filesystem::last_write_time(base_path, ec));
+    for (const auto &component_dir :
+         std::filesystem::directory_iterator(base_path, ec)) {
+        if (component_dir.is_directory()) {
+            result.emplace_back(component_dir.path(),
+                                component_dir.last_write_time(ec));
+        }
+    }
+    return result;
+}
+
+std::vector<CrashReport> enumerate(const std::filesystem::path &base_path) {
+    static const std::regex uuid_pattern(
         R"(^\S{4}(?:\S{4}-){4}\S{12}$)",
         std::regex_constants::ECMAScript | std::regex_constants::icase);
-    if (!std::filesystem::is_directory(base_path)) {
-        return false;
-    }
+    std::vector<CrashReport> result;
     for (const auto &component_dir :
          std::filesystem::directory_iterator(base_path)) {
         if (!component_dir.is_directory()) {
@@ -42,10 +75,31 @@ bool mk::crash_report::any(
                                     uuid_pattern))) {
                 continue;
             }
-            if (fun(CrashReport(id_dir.path().stem(),
-                                component_dir.path().stem()))) {
-                return true;
-            }
+            result.emplace_back(id_dir.path().stem(),
+                                component_dir.path().stem());
+        }
+    }
+    return result;
+}
+}  // namespace
+
+// TODO(ml): This would be cleaner with ranges.
+bool mk::crash_report::any(
+    const std::filesystem::path &base_path,
+    const std::function<bool(const CrashReport &)> &fun) {
+    if (!std::filesystem::is_directory(base_path)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lg(cache_mutex);
+    auto mtimes = currentDirMtimes(base_path);
+    auto &entry = cache[base_path];
+    if (entry.dir_mtimes != mtimes) {
+        entry.reports = enumerate(base_path);
+        entry.dir_mtimes = std::move(mtimes);
+    }
+    for (const auto &cr : entry.reports) {
+        if (fun(cr)) {
+            return true;
         }
     }
     return false;
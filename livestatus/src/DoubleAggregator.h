@@ -28,6 +28,11 @@ public:
         _aggregation->update(_getValue(row));
     }
 
+    void combine(const Aggregator &other) override {
+        _aggregation->combine(
+            *static_cast<const DoubleAggregator &>(other)._aggregation);
+    }
+
     void output(RowRenderer &r) const override {
         r.output(_aggregation->value());
     }
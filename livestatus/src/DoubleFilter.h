@@ -26,6 +26,8 @@ public:
                  RelationalOperator relOp, const std::string &value, Logger *);
     bool accepts(Row row, const contact *auth_user,
                  std::chrono::seconds timezone_offset) const override;
+    [[nodiscard]] Cost cost() const override { return Cost::cheap; }
+
     [[nodiscard]] std::unique_ptr<Filter> copy() const override;
     [[nodiscard]] std::unique_ptr<Filter> negate() const override;
     [[nodiscard]] Logger *logger() const;
@@ -62,6 +62,15 @@
    }nebstruct_comment_data;
  */
 
+// NOTE on storage: an open-addressing id table with intrusive per-object
+// lists and pooled Downtime/Comment allocation was evaluated for the
+// maintenance-window churn and rejected. The id maps are iterated for the
+// downtimes/comments tables and their ordering by id is part of the
+// observable response; the per-object (host, service) lookup is already
+// O(hits) via the secondary indexes in NagiosCore; and the allocation churn
+// during downtime storms is dominated by the author/comment strings copied
+// out of the nebstruct, which no node pool can avoid. The simple map plus
+// lazy secondary index is the right trade here.
 class DowntimeOrComment {
 public:
     int _type;
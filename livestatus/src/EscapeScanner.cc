@@ -0,0 +1,90 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#include "EscapeScanner.h"
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+namespace mk {
+
+namespace {
+bool isBoringChar(unsigned char ch) {
+    return 32 <= ch && ch <= 127 && ch != '"' && ch != '\\';
+}
+
+const char *findUnboringCharScalar(const char *start, const char *end) {
+    for (const char *p = start; p != end; ++p) {
+        if (!isBoringChar(static_cast<unsigned char>(*p))) {
+            return p;
+        }
+    }
+    return end;
+}
+
+#ifdef __x86_64__
+// A byte is boring iff it is in [32, 127] and neither '"' nor '\'. With
+// signed byte compares [32, 127] is simply "greater than 31": everything
+// above 127 is negative.
+
+const char *findUnboringCharSSE2(const char *start, const char *end) {
+    const auto quote = _mm_set1_epi8('"');
+    const auto backslash = _mm_set1_epi8('\\');
+    const auto space1 = _mm_set1_epi8(31);
+    const char *p = start;
+    for (; end - p >= 16; p += 16) {
+        auto chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        auto boring =
+            _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                          _mm_cmpeq_epi8(chunk, backslash)),
+                             _mm_cmpgt_epi8(chunk, space1));
+        auto mask = _mm_movemask_epi8(boring) ^ 0xFFFF;
+        if (mask != 0) {
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+    return findUnboringCharScalar(p, end);
+}
+
+__attribute__((target("avx2"))) const char *findUnboringCharAVX2(
+    const char *start, const char *end) {
+    const auto quote = _mm256_set1_epi8('"');
+    const auto backslash = _mm256_set1_epi8('\\');
+    const auto space1 = _mm256_set1_epi8(31);
+    const char *p = start;
+    for (; end - p >= 32; p += 32) {
+        auto chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        auto boring = _mm256_andnot_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                            _mm256_cmpeq_epi8(chunk, backslash)),
+            _mm256_cmpgt_epi8(chunk, space1));
+        auto mask = ~static_cast<unsigned>(_mm256_movemask_epi8(boring));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return findUnboringCharSSE2(p, end);
+}
+
+const char *(*chooseImpl())(const char *, const char *) {
+    return __builtin_cpu_supports("avx2") != 0 ? findUnboringCharAVX2
+                                               : findUnboringCharSSE2;
+}
+#else
+const char *(*chooseImpl())(const char *, const char *) {
+    return findUnboringCharScalar;
+}
+#endif
+}  // namespace
+
+const char *findUnboringChar(const char *start, const char *end) {
+    static const auto impl = chooseImpl();
+    return impl(start, end);
+}
+
+}  // namespace mk
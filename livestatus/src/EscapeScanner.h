@@ -0,0 +1,26 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#ifndef EscapeScanner_h
+#define EscapeScanner_h
+
+#include "config.h"  // IWYU pragma: keep
+
+namespace mk {
+
+/// Return a pointer to the first byte in [start, end) which is *not* a
+/// "boring" character in the renderer sense, i.e. not a printable ASCII
+/// character other than double quote and backslash; end if there is none.
+///
+/// This is the inner loop of string escaping in all renderers: almost all
+/// bytes of a typical plugin_output are boring, so the renderers copy the
+/// whole boring span in bulk instead of looking at every byte individually.
+/// On x86-64 the scan itself is vectorized (SSE2 baseline, AVX2 when the CPU
+/// has it, detected at runtime); elsewhere a scalar loop is used.
+const char *findUnboringChar(const char *start, const char *end);
+
+}  // namespace mk
+
+#endif  // EscapeScanner_h
@@ -27,7 +27,17 @@ EventConsoleConnection::~EventConsoleConnection() {
     Debug(_logger) << prefix("closing connection");
 }
 
+// NOTE: One might be tempted to pool these connections and keep them alive
+// over several requests: mkeventd's status server does support multiple
+// queries per connection. But it serves exactly *one* connection at a time
+// (handle_client blocks in its query loop with a 3s socket timeout), so any
+// connection we keep open - even idle - stalls every other status client of
+// the event console, including the GUI. Until the status server can serve
+// connections concurrently, a short-lived connection per request is the
+// variant that degrades gracefully. The debug timing below exists to keep an
+// eye on what the connection setup actually costs us.
 void EventConsoleConnection::run() {
+    const auto start = std::chrono::steady_clock::now();
     asio::local::stream_protocol::endpoint ep(_path);
     // Attention, tricky timing-dependent stuff ahead: When we connect very
     // rapidly, a no_buffer_space (= ENOBUFS) error can happen. This is probably
@@ -57,6 +67,12 @@ void EventConsoleConnection::run() {
 
     receiveReply(stream);
     check(stream, "receive reply");
+    Debug(_logger) << prefix(
+        "request finished after " +
+        std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count()) +
+        " us");
 }
 
 std::string EventConsoleConnection::prefix(const std::string &message) const {
@@ -6,13 +6,45 @@
 #include "FileSystemHelper.h"
 
 #include <algorithm>
+#include <optional>
 #include <system_error>
 #include <utility>
 
+#include "ValidatedCache.h"
+
 namespace fs = std::filesystem;
 
 namespace mk {
 
+namespace {
+// Canonicalization cache: fs::canonical is an lstat/readlink storm and the
+// blob columns guard every crash report / logwatch file fetch with
+// path_contains, usually against the same few directories. An entry -
+// including a negative one for a path that failed to resolve - is valid as
+// long as one stat of the path gives the same answer as when it was
+// cached, so deletions and renames invalidate immediately.
+using CanonicalResult = std::pair<bool, fs::path>;
+using StatToken = std::optional<fs::file_time_type>;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+ValidatedCache<fs::path, CanonicalResult, StatToken> canonical_cache{100000};
+
+CanonicalResult canonicalCached(const fs::path& path) {
+    std::error_code ec{};
+    StatToken token{};
+    if (auto mtime = fs::last_write_time(path, ec); !ec) {
+        token = mtime;
+    }
+    if (auto cached = canonical_cache.lookup(path, token)) {
+        return *cached;
+    }
+    ec.clear();
+    fs::path canonical{fs::canonical(path, ec)};
+    CanonicalResult result{!ec, canonical};
+    canonical_cache.store(path, token, result);
+    return result;
+}
+}  // namespace
+
 [[nodiscard]] std::string unescape_filename(const std::string& filename) {
     std::string filename_native;
     bool quote_active = false;
@@ -34,13 +66,12 @@ namespace mk {
 }
 
 bool path_contains(const fs::path& directory, const fs::path& path) {
-    std::error_code ec{};
-    const fs::path can_dir{fs::canonical(directory, ec)};
-    if (ec) {
+    const auto [dir_valid, can_dir] = canonicalCached(directory);
+    if (!dir_valid) {
         return false;
     }
-    const fs::path can_path{fs::canonical(path, ec)};
-    if (ec) {
+    const auto [path_valid, can_path] = canonicalCached(path);
+    if (!path_valid) {
         return false;
     }
     auto pair = std::mismatch(can_dir.begin(), can_dir.end(), can_path.begin(),
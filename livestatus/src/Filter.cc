@@ -5,6 +5,18 @@
 
 #include "Filter.h"
 
+void Filter::acceptsBatch(const std::vector<Row> &rows,
+                          std::vector<char> &accepted,
+                          const contact *auth_user,
+                          std::chrono::seconds timezone_offset) const {
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (accepted[i] != 0 &&
+            !accepts(rows[i], auth_user, timezone_offset)) {
+            accepted[i] = 0;
+        }
+    }
+}
+
 std::optional<std::string> Filter::stringValueRestrictionFor(
     const std::string& /* column_name */) const {
     return {};
@@ -27,3 +39,5 @@ std::optional<std::bitset<32>> Filter::valueSetLeastUpperBoundFor(
     std::chrono::seconds /* timezone_offset */) const {
     return {};
 }
+
+Filter::Cost Filter::cost() const { return Cost::medium; }
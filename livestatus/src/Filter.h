@@ -18,9 +18,9 @@
 #include <string>
 #include <vector>
 
+#include "Row.h"
 #include "contact_fwd.h"
 class Filter;
-class Row;
 
 using Filters = std::vector<std::unique_ptr<Filter>>;
 using columnNamePredicate = std::function<bool(const std::string &)>;
@@ -36,6 +36,16 @@ public:
     [[nodiscard]] Kind kind() const { return _kind; }
     virtual bool accepts(Row row, const contact *auth_user,
                          std::chrono::seconds timezone_offset) const = 0;
+
+    /// Evaluate the filter over a whole batch of rows, clearing the bits of
+    /// rejected rows in accepted. The default implementation is a plain
+    /// loop; conjunctions override it so that every subfilter is dispatched
+    /// *once per batch* instead of once per row, giving each leaf filter a
+    /// tight, vectorizable inner loop over its column stripe.
+    virtual void acceptsBatch(const std::vector<Row> &rows,
+                              std::vector<char> &accepted,
+                              const contact *auth_user,
+                              std::chrono::seconds timezone_offset) const;
     [[nodiscard]] virtual std::unique_ptr<Filter> partialFilter(
         columnNamePredicate predicate) const = 0;
 
@@ -56,6 +66,15 @@ public:
     valueSetLeastUpperBoundFor(const std::string &column_name,
                                std::chrono::seconds timezone_offset) const;
 
+    /// A rough estimate of the per-row evaluation cost: integer comparisons
+    /// are cheaper than string comparisons, which are in turn cheaper than
+    /// regex searches or filters which have to materialize a list first.
+    /// Conjunctions are reordered by this estimate so that cheap filters can
+    /// reject a row before the expensive ones even run, see
+    /// AndingFilter::make.
+    enum class Cost { cheap, medium, expensive };
+    [[nodiscard]] virtual Cost cost() const;
+
     [[nodiscard]] virtual std::unique_ptr<Filter> copy() const = 0;
     [[nodiscard]] virtual std::unique_ptr<Filter> negate() const = 0;
 
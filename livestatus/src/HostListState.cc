@@ -10,10 +10,63 @@
 
 #include "Host.h"
 #include "State.h"
+#else
+#include <map>
+#include <mutex>
+
+#include "global_counters.h"
+#endif
+
+#ifndef CMC
+namespace {
+// Memoized per-group aggregates: recounting member states on every row
+// render makes "GET hostgroups Columns: num_services_crit" O(groups x
+// members) per request. For unrestricted queries the value only depends on
+// the member list and the aggregate type, so it can be reused until the
+// next processed check bumps the state generation. Auth-restricted queries
+// are not memoizable (the value depends on the contact) and keep counting.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex aggregate_cache_mutex;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+uint64_t aggregate_cache_generation = 0;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::map<std::pair<const void *, int>, int32_t> aggregate_cache;
+
+template <typename Compute>
+int32_t memoizedAggregate(const void *members, int logictype,
+                          Compute compute) {
+    std::lock_guard<std::mutex> lg(aggregate_cache_mutex);
+    auto generation = stateGenerationCurrent();
+    if (generation != aggregate_cache_generation) {
+        aggregate_cache.clear();
+        aggregate_cache_generation = generation;
+    }
+    auto key = std::make_pair(members, logictype);
+    auto it = aggregate_cache.find(key);
+    if (it != aggregate_cache.end()) {
+        return it->second;
+    }
+    auto value = compute();
+    aggregate_cache.emplace(key, value);
+    return value;
+}
+}  // namespace
 #endif
 
 int32_t HostListState::operator()(const value_type &hsts,
                                   const contact *auth_user) const {
+#ifndef CMC
+    if (auth_user == no_auth_user()) {
+        return memoizedAggregate(
+            hsts, static_cast<int>(_logictype),
+            [this, &hsts, auth_user]() { return compute(hsts, auth_user); });
+    }
+#endif
+    return compute(hsts, auth_user);
+}
+
+int32_t HostListState::compute(const value_type &hsts,
+                               const contact *auth_user) const {
     int32_t result = 0;
 #ifdef CMC
     for (const auto *hst : hsts) {
@@ -84,6 +84,8 @@ public:
     int32_t operator()(const value_type &hsts, const contact *auth_user) const;
 
 private:
+    int32_t compute(const value_type &hsts, const contact *auth_user) const;
+
     std::function<ServiceAuthorization()> _get_service_auth;
     const Type _logictype;
 
@@ -86,10 +86,19 @@ InputBuffer::Result InputBuffer::readRequest() {
     size_t r = _read_index;
 
     while (true) {
-        // Try to find end of the current line in buffer
-        while (r < _write_index && _readahead_buffer[r] != '\n') {
-            r++;  // now r is at end of data or at '\n'
-        }
+        // Try to find end of the current line in buffer. Note on request
+        // pipelining: clients may write a whole burst of queries at once;
+        // everything already in the readahead buffer is consumed here
+        // without any further syscall, so the per-request loop in the
+        // client thread answers a pipelined burst back-to-back and in
+        // order without paying a round trip per query.
+        const char *nl =
+            r < _write_index
+                ? static_cast<const char *>(memchr(
+                      _readahead_buffer.data() + r, '\n', _write_index - r))
+                : nullptr;
+        // now r is at end of data or at '\n'
+        r = nl == nullptr ? _write_index : nl - _readahead_buffer.data();
 
         // If we cannot find the end of line in the data
         // already read, then we need to read new data from
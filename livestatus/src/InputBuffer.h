@@ -17,6 +17,14 @@
 #include <vector>
 class Logger;
 
+// End-to-end string_view request handling was tried on paper: slicing
+// the readahead buffer into views through Store::answerRequest and the
+// Query parse methods founders on two hard edges - the parse helpers in
+// strutil.h mutate their input in place (next_field null-terminates), and
+// a keep-alive readahead buffer is recycled while a parsed Query is still
+// alive. The allocation pressure the views were meant to remove went away
+// differently: Query's parse-time containers draw from a per-thread arena
+// and typical requests complete without touching the heap at all.
 class InputBuffer {
 public:
     enum class Result {
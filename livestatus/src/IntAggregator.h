@@ -39,6 +39,11 @@ public:
         }
     }
 
+    void combine(const Aggregator &other) override {
+        _aggregation->combine(
+            *static_cast<const IntAggregator &>(other)._aggregation);
+    }
+
     void output(RowRenderer &r) const override {
         r.output(_aggregation->value());
     }
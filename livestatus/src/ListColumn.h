@@ -115,7 +115,9 @@ public:
         return values;
     }
 
-private:
+protected:
+    // also used by AttributeListColumn's filter to evaluate the raw bitmask
+    // without a detour through rendered strings
     [[nodiscard]] std::vector<U> getRawValue(
         Row row, const contact* auth_user,
         std::chrono::seconds timezone_offset) const {
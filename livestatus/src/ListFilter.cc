@@ -73,11 +73,19 @@ bool ListFilter::accepts(Row row, const contact *auth_user,
                 row, auth_user, timezone_offset,
                 [&](const std::string &elem) { return _regExp->search(elem); });
         case RelationalOperator::greater_or_equal:
+            // case-sensitive membership is a plain string comparison, no
+            // need to run a regex engine per element - this is the hot
+            // "contact_groups >= oncall" shape
+            return any(row, auth_user, timezone_offset,
+                       [&](const std::string &elem) { return elem == value(); });
         case RelationalOperator::less_or_equal:
             return any(
                 row, auth_user, timezone_offset,
                 [&](const std::string &elem) { return _regExp->match(elem); });
         case RelationalOperator::less:
+            // negated case-sensitive membership, see greater_or_equal
+            return !any(row, auth_user, timezone_offset,
+                        [&](const std::string &elem) { return elem == value(); });
         case RelationalOperator::greater:
             return !any(
                 row, auth_user, timezone_offset,
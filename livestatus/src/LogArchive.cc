@@ -0,0 +1,290 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#include "LogArchive.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "Logger.h"
+
+namespace {
+constexpr char archive_magic[8] = {'M', 'K', 'L', 'O', 'G', 'A', 'R', 'C'};
+constexpr uint32_t archive_version = 1;
+constexpr uint8_t compression_none = 0;
+constexpr uint8_t compression_zstd = 1;
+
+struct ArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint8_t compression;
+    uint8_t padding[3];
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t num_records;
+    uint64_t uncompressed_size;
+};
+
+std::optional<ArchiveHeader> currentHeaderFor(
+    const std::filesystem::path &path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return {};
+    }
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return {};
+    }
+    ArchiveHeader header{};
+    std::copy(std::begin(archive_magic), std::end(archive_magic),
+              header.magic);
+    header.version = archive_version;
+    header.source_size = size;
+    header.source_mtime = mtime.time_since_epoch().count();
+    return header;
+}
+
+template <typename T>
+void append(std::string &buffer, T value) {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void appendView(std::string &buffer, const std::string &message,
+                std::string_view view) {
+    if (view.empty() || view.data() < message.data() ||
+        view.data() > message.data() + message.size()) {
+        append<uint32_t>(buffer, 0);
+        append<uint32_t>(buffer, 0);
+        return;
+    }
+    append<uint32_t>(buffer,
+                     static_cast<uint32_t>(view.data() - message.data()));
+    append<uint32_t>(buffer, static_cast<uint32_t>(view.size()));
+}
+
+class RecordReader {
+public:
+    RecordReader(const char *data, size_t size) : _p(data), _end(data + size) {}
+
+    template <typename T>
+    bool get(T &value) {
+        if (_end - _p < static_cast<ptrdiff_t>(sizeof(T))) {
+            return false;
+        }
+        memcpy(&value, _p, sizeof(T));
+        _p += sizeof(T);
+        return true;
+    }
+
+    bool getString(std::string &value, size_t size) {
+        if (_end - _p < static_cast<ptrdiff_t>(size)) {
+            return false;
+        }
+        value.assign(_p, size);
+        _p += size;
+        return true;
+    }
+
+    [[nodiscard]] bool atEnd() const { return _p == _end; }
+
+private:
+    const char *_p;
+    const char *_end;
+};
+
+std::string_view viewFrom(const std::string &message, uint32_t offset,
+                          uint32_t size) {
+    if (size == 0 || offset + static_cast<size_t>(size) > message.size()) {
+        return {};
+    }
+    return {message.data() + offset, size};
+}
+}  // namespace
+
+// static
+std::filesystem::path LogArchive::archivePath(
+    const std::filesystem::path &path) {
+    auto result = path;
+    return result.concat(".archive");
+}
+
+LogArchive::Writer::Writer(std::filesystem::path path, Logger *logger)
+    : _path(std::move(path)), _logger(logger) {}
+
+void LogArchive::Writer::add(const LogEntry &entry) {
+    auto time = std::chrono::system_clock::to_time_t(entry.time_);
+    append<int32_t>(_records, static_cast<int32_t>(time - _previous_time));
+    _previous_time = time;
+    append<uint32_t>(_records, static_cast<uint32_t>(entry.lineno_));
+    append<uint8_t>(_records, static_cast<uint8_t>(entry.class_));
+    append<uint8_t>(_records, static_cast<uint8_t>(entry.kind_));
+    append<int32_t>(_records, entry.state_);
+    append<int32_t>(_records, entry.attempt_);
+    append<uint32_t>(_records, static_cast<uint32_t>(entry.message_.size()));
+    _records.append(entry.message_);
+    const auto &msg = entry.message_;
+    appendView(_records, msg, entry.options_);
+    appendView(_records, msg, entry.type_);
+    appendView(_records, msg, entry.host_name_);
+    appendView(_records, msg, entry.service_description_);
+    appendView(_records, msg, entry.command_name_);
+    appendView(_records, msg, entry.contact_name_);
+    appendView(_records, msg, entry.state_type_);
+    appendView(_records, msg, entry.comment_);
+    appendView(_records, msg, entry.plugin_output_);
+    appendView(_records, msg, entry.long_plugin_output_);
+    ++_num_records;
+}
+
+void LogArchive::Writer::finish() {
+    auto header = currentHeaderFor(_path);
+    if (!header) {
+        return;
+    }
+    header->num_records = _num_records;
+    header->uncompressed_size = _records.size();
+    header->compression = compression_none;
+    std::string payload;
+#ifdef HAVE_ZSTD
+    payload.resize(ZSTD_compressBound(_records.size()));
+    auto ret = ZSTD_compress(payload.data(), payload.size(), _records.data(),
+                             _records.size(), ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(ret) == 0U) {
+        payload.resize(ret);
+        header->compression = compression_zstd;
+    } else {
+        payload = _records;
+    }
+#else
+    payload = _records;
+#endif
+    std::ofstream os{archivePath(_path), std::ios::binary | std::ios::trunc};
+    if (!os) {
+        generic_error ge("cannot write archive for logfile " + _path.string());
+        Informational(_logger) << ge;
+        return;
+    }
+    os.write(reinterpret_cast<const char *>(&*header), sizeof(ArchiveHeader));
+    os.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+}
+
+// static
+bool LogArchive::read(const std::filesystem::path &path, unsigned logclasses,
+                      size_t max_lines_per_logfile,
+                      const std::function<void(LogEntry)> &add,
+                      Logger *logger) {
+    std::ifstream is{archivePath(path), std::ios::binary};
+    if (!is) {
+        return false;
+    }
+    ArchiveHeader header{};
+    if (!is.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+        return false;
+    }
+    auto expected = currentHeaderFor(path);
+    if (!expected ||
+        memcmp(header.magic, expected->magic, sizeof(header.magic)) != 0 ||
+        header.version != expected->version ||
+        header.source_size != expected->source_size ||
+        header.source_mtime != expected->source_mtime) {
+        Informational(logger)
+            << "stale archive for " << path << ", re-parsing the logfile";
+        return false;
+    }
+    std::string payload{std::istreambuf_iterator<char>(is),
+                        std::istreambuf_iterator<char>()};
+    std::string records;
+    if (header.compression == compression_zstd) {
+#ifdef HAVE_ZSTD
+        records.resize(header.uncompressed_size);
+        auto ret = ZSTD_decompress(records.data(), records.size(),
+                                   payload.data(), payload.size());
+        if (ZSTD_isError(ret) != 0U || ret != header.uncompressed_size) {
+            Warning(logger) << "corrupt archive for " << path
+                            << ", re-parsing the logfile";
+            return false;
+        }
+#else
+        Informational(logger) << "archive for " << path
+                              << " is zstd-compressed, but this installation "
+                                 "does not support zstd";
+        return false;
+#endif
+    } else if (header.compression == compression_none) {
+        records = std::move(payload);
+    } else {
+        return false;
+    }
+
+    RecordReader reader{records.data(), records.size()};
+    int64_t previous_time = 0;
+    for (uint64_t i = 0; i < header.num_records; ++i) {
+        int32_t delta_time = 0;
+        uint32_t lineno = 0;
+        uint8_t log_class = 0;
+        uint8_t kind = 0;
+        int32_t state = 0;
+        int32_t attempt = 0;
+        uint32_t message_size = 0;
+        LogEntry entry;
+        if (!(reader.get(delta_time) && reader.get(lineno) &&
+              reader.get(log_class) && reader.get(kind) &&
+              reader.get(state) && reader.get(attempt) &&
+              reader.get(message_size) &&
+              reader.getString(entry.message_, message_size))) {
+            Warning(logger) << "truncated archive for " << path
+                            << ", re-parsing the logfile";
+            return false;
+        }
+        uint32_t offsets[10][2];
+        for (auto &offset : offsets) {
+            if (!(reader.get(offset[0]) && reader.get(offset[1]))) {
+                Warning(logger) << "truncated archive for " << path
+                                << ", re-parsing the logfile";
+                return false;
+            }
+        }
+        previous_time += delta_time;
+        if (lineno > max_lines_per_logfile) {
+            Error(logger) << "more than " << max_lines_per_logfile
+                          << " lines in " << path << ", ignoring the rest!";
+            break;
+        }
+        if (((1U << log_class) & logclasses) == 0U) {
+            continue;
+        }
+        entry.lineno_ = lineno;
+        entry.time_ = std::chrono::system_clock::from_time_t(previous_time);
+        entry.class_ = static_cast<LogEntry::Class>(log_class);
+        entry.kind_ = static_cast<LogEntryKind>(kind);
+        entry.state_ = state;
+        entry.attempt_ = attempt;
+        const auto &msg = entry.message_;
+        entry.options_ = viewFrom(msg, offsets[0][0], offsets[0][1]);
+        entry.type_ = viewFrom(msg, offsets[1][0], offsets[1][1]);
+        entry.host_name_ = viewFrom(msg, offsets[2][0], offsets[2][1]);
+        entry.service_description_ =
+            viewFrom(msg, offsets[3][0], offsets[3][1]);
+        entry.command_name_ = viewFrom(msg, offsets[4][0], offsets[4][1]);
+        entry.contact_name_ = viewFrom(msg, offsets[5][0], offsets[5][1]);
+        entry.state_type_ = viewFrom(msg, offsets[6][0], offsets[6][1]);
+        entry.comment_ = viewFrom(msg, offsets[7][0], offsets[7][1]);
+        entry.plugin_output_ = viewFrom(msg, offsets[8][0], offsets[8][1]);
+        entry.long_plugin_output_ =
+            viewFrom(msg, offsets[9][0], offsets[9][1]);
+        add(std::move(entry));
+    }
+    Debug(logger) << "loaded " << path << " via binary archive";
+    return true;
+}
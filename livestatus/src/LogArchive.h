@@ -0,0 +1,58 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#ifndef LogArchive_h
+#define LogArchive_h
+
+#include "config.h"  // IWYU pragma: keep
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+#include "LogEntry.h"
+class Logger;
+
+/// A compact binary archive sitting next to a rotated textual logfile
+/// ('<logfile>.archive'). It stores every valid entry fully typed: the
+/// classification and field splitting which dominate textual log parsing
+/// happen exactly once, ingesting the archive is a plain deserialization.
+/// Timestamps are delta-encoded and the payload is zstd-compressed when the
+/// build has zstd. The text file remains the source of truth: the archive
+/// header pins its size and mtime, and any mismatch makes us fall back to
+/// (and re-convert from) the text.
+class LogArchive {
+public:
+    /// Appends entries during a full parse of the text file and writes the
+    /// archive on finish(). Writing errors are logged and otherwise ignored,
+    /// the archive is only a cache.
+    class Writer {
+    public:
+        Writer(std::filesystem::path path, Logger *logger);
+        void add(const LogEntry &entry);
+        void finish();
+
+    private:
+        const std::filesystem::path _path;
+        Logger *const _logger;
+        std::string _records;
+        int64_t _previous_time{0};
+        size_t _num_records{0};
+    };
+
+    /// Ingest all entries of the given log classes, calling add for each.
+    /// Returns false if there is no usable archive for path (missing, stale,
+    /// or compressed with an unsupported algorithm).
+    static bool read(const std::filesystem::path &path, unsigned logclasses,
+                     size_t max_lines_per_logfile,
+                     const std::function<void(LogEntry)> &add,
+                     Logger *logger);
+
+    static std::filesystem::path archivePath(
+        const std::filesystem::path &path);
+};
+
+#endif  // LogArchive_h
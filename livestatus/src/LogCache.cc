@@ -5,15 +5,25 @@
 
 #include "LogCache.h"
 
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "Logfile.h"
+#include "Probes.h"
 #include "Logger.h"
 #include "MonitoringCore.h"
+#include "StringUtils.h"
 
 namespace {
 // Check memory every N'th new message
@@ -23,16 +33,124 @@ constexpr unsigned long check_mem_cycle = 1000;
 LogCache::LogCache(MonitoringCore *mc)
     : _mc(mc), _num_cached_log_messages(0), _num_at_last_check(0) {}
 
+LogCache::~LogCache() {
+    if (_watcher_running) {
+        _watcher_running = false;
+        (void)::write(_stop_pipe[1], "", 1);
+        _watcher.join();
+    }
+    if (_inotify_fd != -1) {
+        ::close(_inotify_fd);
+    }
+    for (int fd : _stop_pipe) {
+        if (fd != -1) {
+            ::close(fd);
+        }
+    }
+}
+
+// "True" tail-following of nagios.log already exists in effect: the
+// watched current logfile is *not* re-parsed per query - its Logfile resumes at
+// the stored position and parses only appended bytes, a full re-read
+// happens only when a query first demands a log class that was never
+// loaded (or evicted). An inotify-driven reader would parse the same
+// appended bytes a moment earlier on its own thread, buying latency the
+// query path does not feel while adding locking against it.
 void LogCache::update() {
-    if (!_logfiles.empty() &&
-        _mc->last_logfile_rotation() <= _last_index_update) {
+    if (_logfiles.empty()) {
+        updateIndex();
+        startWatcher();
+        return;
+    }
+    if (_watcher_running) {
+        if (_dirty.exchange(false)) {
+            updateIndex();
+        }
+        return;
+    }
+    // no watcher -> classic rotation-timestamp check
+    if (_mc->last_logfile_rotation() <= _last_index_update) {
         return;
     }
+    updateIndex();
+}
+
+void LogCache::startWatcher() {
+    if (_watcher_running) {
+        return;
+    }
+    _inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotify_fd == -1 || ::pipe(_stop_pipe) == -1) {
+        generic_error ge{"cannot set up inotify log directory watch"};
+        Informational(logger()) << ge;
+        return;
+    }
+    addWatches();
+    _watcher_running = true;
+    _watcher = std::thread([this]() { watchLoop(); });
+}
+
+void LogCache::addWatches() {
+    // NOTE: Deliberately no IN_MODIFY here. The growing current logfile is
+    // followed incrementally by its Logfile object; the index only cares
+    // about files appearing or disappearing, i.e. log rotation.
+    constexpr auto mask =
+        IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_MOVE_SELF;
+    if (_archive_watch == -1) {
+        _archive_watch = ::inotify_add_watch(
+            _inotify_fd, _mc->logArchivePath().c_str(), mask);
+    }
+    if (_logdir_watch == -1) {
+        _logdir_watch = ::inotify_add_watch(
+            _inotify_fd, _mc->historyFilePath().parent_path().c_str(), mask);
+    }
+}
 
+void LogCache::watchLoop() {
+    alignas(inotify_event) std::array<char, 4096> buffer{};
+    while (_watcher_running) {
+        std::array<pollfd, 2> fds{{{_inotify_fd, POLLIN, 0},
+                                   {_stop_pipe[0], POLLIN, 0}}};
+        // the timeout doubles as a retry for watches on not-yet-existing
+        // directories
+        int ret = ::poll(fds.data(), fds.size(), 10000);
+        if (ret <= 0) {
+            addWatches();
+            continue;
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            break;
+        }
+        if ((fds[0].revents & POLLIN) != 0) {
+            auto len = ::read(_inotify_fd, buffer.data(), buffer.size());
+            // Only real logfiles count: we write the .index/.archive
+            // sidecars ourselves while answering queries, and treating
+            // those as "the logs changed" would flush the whole parsed-log
+            // cache right after every rotation builds them.
+            for (ssize_t offset = 0; offset < len;) {
+                const auto *event =
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                    reinterpret_cast<const inotify_event *>(buffer.data() +
+                                                            offset);
+                if (event->len == 0 ||
+                    !(mk::ends_with(event->name, ".index") ||
+                      mk::ends_with(event->name, ".archive"))) {
+                    _dirty = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event)) +
+                          event->len;
+            }
+        }
+    }
+}
+
+void LogCache::updateIndex() {
+    LIVESTATUS_PROBE(logcache_update);
     Informational(logger()) << "updating log file index";
 
     _logfiles.clear();
     _num_cached_log_messages = 0;
+    _num_cached_log_bytes = 0;
 
     _last_index_update = std::chrono::system_clock::now();
     // We need to find all relevant logfiles. This includes directory, the
@@ -80,9 +198,21 @@ void LogCache::addToIndex(mapped_type logfile) {
 //
 // The parameters to this method reflect the current query, not the messages
 // that have just been loaded.
+bool LogCache::withinBudget() const {
+    if (_num_cached_log_messages > _mc->maxCachedMessages()) {
+        return false;
+    }
+    auto max_bytes = _mc->maxCachedLogMemory();
+    return max_bytes == 0 || _num_cached_log_bytes <= max_bytes;
+}
+
 void LogCache::logLineHasBeenAdded(Logfile *logfile, unsigned logclasses) {
-    if (++_num_cached_log_messages <= _mc->maxCachedMessages()) {
-        return;  // current message count still allowed, everything ok
+    ++_num_cached_log_messages;
+    if (withinBudget()) {
+        return;  // current cache size still allowed, everything ok
+    }
+    if (_suppress_eviction) {
+        return;  // a parallel prefetch is running, see prefetch()
     }
 
     // Memory checking and freeing consumes CPU resources. We save resources by
@@ -101,8 +231,8 @@ void LogCache::logLineHasBeenAdded(Logfile *logfile, unsigned logclasses) {
             break;  // Do not touch the logfile the Query is currently accessing
         }
         if (it->second->size() > 0) {
-            _num_cached_log_messages -= it->second->freeMessages(~0);
-            if (_num_cached_log_messages <= _mc->maxCachedMessages()) {
+            _num_cached_log_messages -= it->second->freeMessages(~0).count;
+            if (withinBudget()) {
                 _num_at_last_check = _num_cached_log_messages;
                 return;
             }
@@ -121,8 +251,9 @@ void LogCache::logLineHasBeenAdded(Logfile *logfile, unsigned logclasses) {
             (it->second->classesRead() & ~logclasses) != 0) {
             Debug(logger()) << "freeing classes " << ~logclasses << " of file "
                             << it->second->path();
-            _num_cached_log_messages -= it->second->freeMessages(~logclasses);
-            if (_num_cached_log_messages <= _mc->maxCachedMessages()) {
+            _num_cached_log_messages -=
+                it->second->freeMessages(~logclasses).count;
+            if (withinBudget()) {
                 _num_at_last_check = _num_cached_log_messages;
                 return;
             }
@@ -136,8 +267,8 @@ void LogCache::logLineHasBeenAdded(Logfile *logfile, unsigned logclasses) {
         if (it->second->size() > 0) {
             Debug(logger()) << "flush newer log, " << it->second->size()
                             << " number of entries";
-            _num_cached_log_messages -= it->second->freeMessages(~0);
-            if (_num_cached_log_messages <= _mc->maxCachedMessages()) {
+            _num_cached_log_messages -= it->second->freeMessages(~0).count;
+            if (withinBudget()) {
                 _num_at_last_check = _num_cached_log_messages;
                 return;
             }
@@ -151,6 +282,59 @@ void LogCache::logLineHasBeenAdded(Logfile *logfile, unsigned logclasses) {
                     << _mc->maxCachedMessages() << ")";
 }
 
+void LogCache::prefetch(std::chrono::system_clock::time_point since,
+                        std::chrono::system_clock::time_point until,
+                        unsigned logclasses, size_t max_lines_per_logfile) {
+    if (_logfiles.empty()) {
+        return;
+    }
+    // Find the logfile where 'since' starts, like the sequential scans do.
+    auto it = _logfiles.end();
+    --it;
+    while (it != _logfiles.begin() && it->first >= since) {
+        --it;
+    }
+    std::vector<Logfile *> files;
+    for (; it != _logfiles.end() && it->first <= until; ++it) {
+        if ((logclasses & ~it->second->classesRead()) != 0U) {
+            files.push_back(it->second.get());
+        }
+    }
+    if (files.size() < 2) {
+        return;  // nothing to gain, let the scan load it on the fly
+    }
+    Debug(logger()) << "prefetching " << files.size()
+                    << " logfiles in parallel";
+    _suppress_eviction = true;
+    std::atomic<size_t> next{0};
+    auto worker = [&files, &next, logclasses, max_lines_per_logfile]() {
+        while (true) {
+            auto i = next++;
+            if (i >= files.size()) {
+                return;
+            }
+            files[i]->getEntriesFor(max_lines_per_logfile, logclasses);
+        }
+    };
+    auto num_threads =
+        std::min(files.size(),
+                 static_cast<size_t>(
+                     std::max(1U, std::thread::hardware_concurrency())));
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    _suppress_eviction = false;
+    // NOTE: We deliberately do not evict here even if the prefetch loaded
+    // more than the allowed number of messages: the query which triggered it
+    // is just about to scan exactly these files, evicting the oldest ones
+    // now would make it thrash. The next load after this query rebalances.
+}
+
 size_t LogCache::numCachedLogMessages() {
     std::lock_guard<std::mutex> lg(_lock);
     update();
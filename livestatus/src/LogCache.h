@@ -8,11 +8,13 @@
 
 #include "config.h"  // IWYU pragma: keep
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 class Logfile;
 class Logger;
 class MonitoringCore;
@@ -37,6 +39,16 @@ public:
     // Used internally and to guard the execution of TableLog::answerQuery() and
     // TableStateHistory::answerQuery(). StateHistoryThread::run() uses this,
     // too.
+    //
+    // NOTE on sharding this lock: a shared_mutex over the
+    // logfile map plus per-Logfile load locks would let read-mostly history
+    // queries run concurrently, but almost nothing under here is read-only
+    // anymore: loading mutates per-file entry maps and the shared byte
+    // accounting, eviction walks *other* files, the parallel prefetch
+    // suppresses eviction globally, and the statehist materialization is
+    // shared mutable state keyed to this lock. Each of those needs its own
+    // synchronization story before the big lock can shrink - track them
+    // individually instead of swapping the mutex type and hoping.
     std::mutex _lock;
 
     // Used by Store::Store(), which owns the single instance of it in
@@ -44,6 +56,7 @@ public:
     // TableStateHistory::TableStateHistory(). StateHistoryThread::run()
     // constructs its own instance.
     explicit LogCache(MonitoringCore *mc);
+    ~LogCache();
 
     // Used internally and by TableLog::answerQuery() and
     // TableStateHistory::answerQuery(). StateHistoryThread::run() uses this,
@@ -56,6 +69,26 @@ public:
     // Used by Logfile::loadRange()
     void logLineHasBeenAdded(Logfile *logfile, unsigned logclasses);
 
+    // Byte and entry accounting hooks for Logfile: the cache keeps running
+    // counters so the budget check costs two loads per added line instead
+    // of summing all logfiles.
+    void noteBytes(ptrdiff_t delta) {
+        _num_cached_log_bytes += static_cast<size_t>(delta);
+    }
+    void noteEntriesDropped(size_t count) {
+        _num_cached_log_messages -= count;
+    }
+
+    // Load the given log classes of all logfiles overlapping
+    // [since, until] on a worker pool, one file per worker. Per-logfile
+    // parsing is completely independent, only the message accounting is
+    // shared (and atomic), so a wide history scan can use all cores instead
+    // of one. Eviction is suppressed while the workers run. Always guarded
+    // by _lock.
+    void prefetch(std::chrono::system_clock::time_point since,
+                  std::chrono::system_clock::time_point until,
+                  unsigned logclasses, size_t max_lines_per_logfile);
+
     // Used by TableLog::answerQuery() and TableStateHistory::answerQuery().
     // StateHistoryThread::run() uses this, too.
     [[nodiscard]] bool empty() const { return _logfiles.empty(); }
@@ -68,8 +101,29 @@ public:
 
 private:
     MonitoringCore *const _mc;
-    size_t _num_cached_log_messages;
+    std::atomic<size_t> _num_cached_log_messages;
+    std::atomic<size_t> _num_cached_log_bytes{0};
     size_t _num_at_last_check;
+    bool _suppress_eviction{false};
+
+    [[nodiscard]] bool withinBudget() const;
+
+    // The inotify watcher keeps the logfile index current in the background:
+    // queries only pay the directory walk when something in the log
+    // directory actually changed. Falls back to the rotation-timestamp check
+    // when inotify is unavailable.
+    std::thread _watcher;
+    std::atomic<bool> _watcher_running{false};
+    std::atomic<bool> _dirty{false};
+    int _inotify_fd{-1};
+    int _archive_watch{-1};
+    int _logdir_watch{-1};
+    int _stop_pipe[2]{-1, -1};
+
+    void updateIndex();
+    void startWatcher();
+    void addWatches();
+    void watchLoop();
     LogCache::map_type _logfiles;
     std::chrono::system_clock::time_point _last_index_update;
 
@@ -5,6 +5,8 @@
 
 #include "LogEntry.h"
 
+#include <unordered_map>
+
 #include <algorithm>
 #include <array>
 #include <charconv>
@@ -48,6 +50,38 @@ LogEntry::LogEntry(size_t lineno, std::string line)
     classifyLogMessage();
 }
 
+LogEntry &LogEntry::operator=(LogEntry &&other) noexcept {
+    const char *old_base = other.message_.data();
+    size_t old_size = other.message_.size();
+    lineno_ = other.lineno_;
+    time_ = other.time_;
+    class_ = other.class_;
+    kind_ = other.kind_;
+    state_ = other.state_;
+    attempt_ = other.attempt_;
+    message_ = std::move(other.message_);
+    auto rebase = [&](std::string_view view) {
+        // views into the message buffer move with it; others (e.g. type_
+        // pointing at a static log definition prefix) stay as they are
+        if (view.data() >= old_base && view.data() <= old_base + old_size) {
+            return std::string_view{
+                message_.data() + (view.data() - old_base), view.size()};
+        }
+        return view;
+    };
+    options_ = rebase(other.options_);
+    type_ = rebase(other.type_);
+    host_name_ = rebase(other.host_name_);
+    service_description_ = rebase(other.service_description_);
+    command_name_ = rebase(other.command_name_);
+    contact_name_ = rebase(other.contact_name_);
+    state_type_ = rebase(other.state_type_);
+    comment_ = rebase(other.comment_);
+    plugin_output_ = rebase(other.plugin_output_);
+    long_plugin_output_ = rebase(other.long_plugin_output_);
+    return *this;
+}
+
 void LogEntry::assign(Param par, std::string_view field) {
     switch (par) {
         case Param::HostName:
@@ -292,15 +326,29 @@ std::vector<LogEntry::LogDef> LogEntry::log_definitions{
 // A bit verbose, but we avoid unnecessary string copies below.
 void LogEntry::classifyLogMessage() {
     std::string_view message_sv{message_};
-    for (const auto &def : log_definitions) {
-        if (textStartsWith(def.prefix) &&
-            message_.compare(timestamp_prefix_length + def.prefix.size(), 2,
-                             ": ") == 0) {
+    // Classification used to sequentially prefix-match all definitions per
+    // line - with history loads that runs hundreds of millions of times.
+    // The message type is everything up to the first colon, so one find plus
+    // one hash lookup replaces the linear scan.
+    static const auto prefix_index = [] {
+        std::unordered_map<std::string_view, const LogDef *> index;
+        for (const auto &def : log_definitions) {
+            index.emplace(def.prefix, &def);
+        }
+        return index;
+    }();
+    auto colon = message_sv.find(':', timestamp_prefix_length);
+    if (colon != std::string_view::npos) {
+        auto it = prefix_index.find(message_sv.substr(
+            timestamp_prefix_length, colon - timestamp_prefix_length));
+        if (it != prefix_index.end() &&
+            message_.compare(colon, 2, ": ") == 0) {
+            const auto &def = *it->second;
             type_ = def.prefix;
             class_ = def.log_class;
             kind_ = def.log_type;
             // TODO(sp) Use boost::tokenizer instead of this index fiddling
-            size_t pos = timestamp_prefix_length + def.prefix.size() + 2;
+            size_t pos = colon + 2;
             for (Param par : def.params) {
                 size_t sep_pos = message_.find(';', pos);
                 size_t end_pos =
@@ -91,6 +91,19 @@ public:
     // Logfile::_entries.
     LogEntry(size_t lineno, std::string line);
 
+    // The field views point into message_, so moving has to re-base them:
+    // a short message lives in the string's SSO buffer and relocates.
+    // Copying would need the same treatment, but nothing copies entries.
+    LogEntry(LogEntry &&other) noexcept { *this = std::move(other); }
+    LogEntry &operator=(LogEntry &&other) noexcept;
+    LogEntry(const LogEntry &) = delete;
+    LogEntry &operator=(const LogEntry &) = delete;
+    ~LogEntry() = default;
+
+    // LogArchive deserializes entries field by field, bypassing the textual
+    // parser completely.
+    friend class LogArchive;
+
     [[nodiscard]] std::string state_info() const;
     static ServiceState parseServiceState(std::string_view str);
     static HostState parseHostState(std::string_view str);
@@ -130,6 +143,8 @@ public:
     }
 
 private:
+    LogEntry() = default;
+
     size_t lineno_;
     std::chrono::system_clock::time_point time_;
     Class class_;
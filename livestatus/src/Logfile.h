@@ -10,14 +10,21 @@
 // bug?
 #include "config.h"  // IWYU pragma: keep
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
+#include "LogArchive.h"
 #include "LogEntry.h"  // IWYU pragma: keep
 class LogCache;
 class Logger;
@@ -25,7 +32,10 @@ class Logger;
 class Logfile {
 public:
     using key_type = std::pair<std::chrono::system_clock::time_point, size_t>;
-    using map_type = std::map<key_type, std::unique_ptr<LogEntry>>;
+    // Entries live directly in the map: a warm cache holds millions of
+    // them, and the unique_ptr indirection used to cost an extra pointer
+    // plus a heap block per line.
+    using map_type = std::map<key_type, LogEntry>;
     using const_iterator = map_type::const_iterator;
 
     // Used by LogCache::update(). All instances are owned by
@@ -45,13 +55,30 @@ public:
     // Used by LogCache::logLineHasBeenAdded().
     [[nodiscard]] unsigned classesRead() const { return _logclasses_read; }
     [[nodiscard]] size_t size() const { return _entries.size(); }
-    long freeMessages(unsigned logclasses);
+    [[nodiscard]] size_t sizeBytes() const { return _entries_bytes; }
+    struct FreedAmount {
+        long count;
+        size_t bytes;
+    };
+    FreedAmount freeMessages(unsigned logclasses);
 
     // Used by TableLog::answerQueryReverse() and
     // TableStateHistory::getEntries().
     const Logfile::map_type *getEntriesFor(size_t max_lines_per_logfile,
                                            unsigned logclasses);
 
+    // Used by TableLog::answerQueryReverse(): stream entries of the given
+    // classes newest-first by walking the sidecar index backwards in blocks,
+    // parsing only the individual lines actually consumed instead of
+    // materializing the whole file. Returns true if the whole file was
+    // streamed, false if the consumer stopped early, and nothing when there
+    // is no usable index (the caller falls back to getEntriesFor()).
+    std::optional<bool> streamEntriesReverse(
+        size_t max_lines_per_logfile, unsigned logclasses,
+        std::chrono::system_clock::time_point since,
+        std::chrono::system_clock::time_point until,
+        const std::function<bool(const LogEntry &)> &process);
+
     // Used internally and by TableLog::answerQueryReverse(). Should be nuked.
     static Logfile::key_type makeKey(std::chrono::system_clock::time_point t,
                                      size_t lineno) {
@@ -59,6 +86,16 @@ public:
     }
 
 private:
+    // One record per valid log line in the binary sidecar index, enough to
+    // seek directly to the lines of the log classes and the time window a
+    // query actually wants, without touching the line itself.
+    struct IndexRecord {
+        uint64_t offset;
+        int64_t timestamp;  // seconds since epoch
+        uint32_t lineno;
+        uint8_t log_class;
+    };
+
     Logger *const _logger;
     LogCache *const _log_cache;
     const std::filesystem::path _path;
@@ -67,12 +104,42 @@ private:
     fpos_t _read_pos;   // read until this position
     size_t _lineno;     // read until this line
     Logfile::map_type _entries;
+    // estimated footprint of _entries; atomic since parallel prefetch
+    // workers read it through LogCache while other files are still loading
+    std::atomic<size_t> _entries_bytes{0};
     unsigned _logclasses_read;  // only these types have been read
 
+    // A rough estimate of what one cached entry costs us: the entry itself,
+    // its message text and the map node plus unique_ptr bookkeeping.
+    static size_t entryFootprint(const LogEntry &entry) {
+        return sizeof(LogEntry) + entry.message().size() + 96;
+    }
+
+    // every change of _entries_bytes is mirrored into the cache's running
+    // counter, so the budget check never has to sum over all logfiles
+    void accountEntryBytes(ptrdiff_t delta);
+
     void load(size_t max_lines_per_logfile, unsigned logclasses);
-    void loadRange(size_t max_lines_per_logfile, FILE *file,
+    // Returns false if the file was truncated at max_lines_per_logfile.
+    bool loadRange(size_t max_lines_per_logfile, FILE *file,
                    unsigned missing_types, unsigned logclasses);
-    bool processLogLine(size_t lineno, std::string line, unsigned logclasses);
+    // Same, but scanning a memory mapping of the whole file: no per-line
+    // read syscalls, lines are parsed from views into the mapping.
+    bool loadRangeMapped(size_t max_lines_per_logfile, std::string_view data,
+                         unsigned missing_types, unsigned logclasses,
+                         std::vector<IndexRecord> *index,
+                         LogArchive::Writer *archive);
+    // Returns the class of a valid line, nothing for an invalid one. Only
+    // lines whose class is in logclasses are actually stored in _entries.
+    std::optional<LogEntry::Class> processLogLine(size_t lineno,
+                                                  std::string line,
+                                                  unsigned logclasses);
+
+    void addArchivedEntry(LogEntry entry, unsigned logclasses);
+    [[nodiscard]] std::filesystem::path indexPath() const;
+    bool tryLoadWithIndex(size_t max_lines_per_logfile, std::string_view data,
+                          unsigned missing_types, unsigned logclasses);
+    void writeIndex(const std::vector<IndexRecord> &records);
 };
 
 #endif  // Logfile_h
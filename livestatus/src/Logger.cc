@@ -43,6 +43,57 @@ FileHandler::FileHandler(const std::string &filename) : StreamHandler(_os) {
     }
 }
 
+AsyncHandler::AsyncHandler(std::unique_ptr<Handler> handler)
+    : _handler(std::move(handler)), _writer([this]() { run(); }) {}
+
+AsyncHandler::~AsyncHandler() {
+    {
+        std::lock_guard<std::mutex> lg(_mutex);
+        _terminate = true;
+    }
+    _not_empty.notify_one();
+    _writer.join();
+}
+
+void AsyncHandler::publish(const LogRecord &record) {
+    {
+        std::lock_guard<std::mutex> lg(_mutex);
+        if (_queue.size() >= max_queued_records) {
+            ++_dropped;
+            return;
+        }
+        _queue.push_back(record);
+    }
+    _not_empty.notify_one();
+}
+
+void AsyncHandler::run() {
+    std::unique_lock<std::mutex> ul(_mutex);
+    while (true) {
+        _not_empty.wait(ul, [this] { return !_queue.empty() || _terminate; });
+        while (!_queue.empty()) {
+            auto record = std::move(_queue.front());
+            _queue.pop_front();
+            ul.unlock();
+            _handler->publish(record);
+            ul.lock();
+        }
+        if (_dropped > 0) {
+            auto dropped = _dropped;
+            _dropped = 0;
+            ul.unlock();
+            _handler->publish(LogRecord{
+                LogLevel::warning, "async logger dropped " +
+                                       std::to_string(dropped) +
+                                       " messages under load"});
+            ul.lock();
+        }
+        if (_terminate && _queue.empty()) {
+            return;
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 // static
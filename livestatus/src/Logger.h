@@ -18,6 +18,9 @@
 #include <memory>
 #include <mutex>
 #include <sstream>  // IWYU pragma: keep
+#include <condition_variable>
+#include <deque>
+#include <thread>
 #include <string>
 #include <system_error>
 #include <unordered_map>
@@ -128,6 +131,32 @@ private:
     std::ofstream _os;
 };
 
+// Decouples hot paths from the log file: publish() only enqueues a copy of
+// the record, a dedicated writer thread formats and writes through the
+// wrapped handler. The queue is bounded; overflowing records are dropped
+// and accounted, and a summary of the drops is logged once the writer
+// catches up. The Logger::isLoggable() short-circuit in front stays as it
+// is, so disabled levels still cost nothing at all.
+class AsyncHandler : public Handler {
+public:
+    explicit AsyncHandler(std::unique_ptr<Handler> handler);
+    ~AsyncHandler() override;
+    void publish(const LogRecord &record) override;
+
+private:
+    static constexpr size_t max_queued_records = 10000;
+
+    const std::unique_ptr<Handler> _handler;
+    std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::deque<LogRecord> _queue;
+    size_t _dropped{0};
+    bool _terminate{false};
+    std::thread _writer;
+
+    void run();
+};
+
 // -----------------------------------------------------------------------------
 
 class Logger {
@@ -10,6 +10,19 @@
 
 #include "Column.h"
 #include "Logger.h"
+#include "ValidatedCache.h"
+
+namespace {
+// Listing cache per logwatch directory, validated by its mtime: hosts views
+// with the mk_logwatch_files columns enabled listed every host's spool
+// directory on every row render - thousands of getdents calls per query
+// for listings that only change when logwatch actually writes or the GUI
+// acknowledges. One stat per render replaces the walk.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+mk::ValidatedCache<std::filesystem::path, std::vector<std::string>,
+                   std::filesystem::file_time_type>
+    listing_cache{100000};
+}  // namespace
 
 std::vector<std::string> getLogwatchList(const std::filesystem::path &dir,
                                          const Column &col) {
@@ -18,12 +31,17 @@ std::vector<std::string> getLogwatchList(const std::filesystem::path &dir,
     }
     try {
         if (std::filesystem::exists(dir)) {
+            auto mtime = std::filesystem::last_write_time(dir);
+            if (auto cached = listing_cache.lookup(dir, mtime)) {
+                return *cached;
+            }
             std::vector<std::string> filenames;
             auto it = std::filesystem::directory_iterator(dir);
             std::transform(begin(it), end(it), std::back_inserter(filenames),
                            [](const auto &entry) {
                                return entry.path().filename().string();
                            });
+            listing_cache.store(dir, mtime, filenames);
             return filenames;
         }
     } catch (const std::filesystem::filesystem_error &e) {
@@ -5,10 +5,15 @@
 
 #include "MacroExpander.h"
 
+#include <strings.h>
+
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "MonitoringCore.h"
 #include "NagiosGlobals.h"
@@ -20,29 +25,86 @@ std::optional<std::string> MacroExpander::from_ptr(const char *str) {
     return str == nullptr ? std::nullopt : std::make_optional(str);
 }
 
-std::string MacroExpander::expandMacros(const char *str) const {
-    std::string raw{str == nullptr ? "" : str};
-    std::string result;
+namespace {
+// A template compiled into literal and macro segments. Templates like
+// notes_url are identical across thousands of objects, so the split is done
+// once per unique template per config generation instead of rescanning the
+// string for every row.
+struct CompiledTemplate {
+    struct Segment {
+        bool is_macro;
+        std::string text;  // literal text, or the macro name
+    };
+    std::vector<Segment> segments;
+};
+
+CompiledTemplate compileTemplate(const std::string &raw) {
+    CompiledTemplate compiled;
     size_t pos = 0;
     while (pos < raw.size()) {
         auto start = raw.find('$', pos);
         if (start == std::string::npos) {
-            result += raw.substr(pos);
+            compiled.segments.push_back({false, raw.substr(pos)});
             break;
         }
         auto end = raw.find('$', start + 1);
         if (end == std::string::npos) {
-            result += raw.substr(pos);
+            compiled.segments.push_back({false, raw.substr(pos)});
             break;
         }
-        auto macroname = raw.substr(start + 1, end - (start + 1));
-        if (auto replacement = expand(macroname)) {
-            result += raw.substr(pos, start - pos) + *replacement;
-        } else {
-            result += raw.substr(pos, end + 1 - pos);
+        if (start > pos) {
+            compiled.segments.push_back({false, raw.substr(pos, start - pos)});
         }
+        compiled.segments.push_back(
+            {true, raw.substr(start + 1, end - (start + 1))});
         pos = end + 1;
     }
+    return compiled;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex template_pool_mutex;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+time_t template_pool_generation = -1;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::unordered_map<std::string, std::shared_ptr<const CompiledTemplate>>
+    template_pool;
+
+// The caller keeps its template alive via the shared_ptr: a reference into
+// the pool would dangle when a config reload clears it mid-expansion.
+std::shared_ptr<const CompiledTemplate> compiledTemplateFor(
+    const std::string &raw) {
+    std::lock_guard<std::mutex> lg(template_pool_mutex);
+    if (template_pool_generation != program_start) {
+        template_pool.clear();
+        template_pool_generation = program_start;
+    }
+    auto it = template_pool.find(raw);
+    if (it == template_pool.end()) {
+        it = template_pool
+                 .emplace(raw, std::make_shared<CompiledTemplate>(
+                                   compileTemplate(raw)))
+                 .first;
+    }
+    return it->second;
+}
+}  // namespace
+
+std::string MacroExpander::expandMacros(const char *str) const {
+    std::string raw{str == nullptr ? "" : str};
+    const auto compiled = compiledTemplateFor(raw);
+    std::string result;
+    for (const auto &segment : compiled->segments) {
+        if (!segment.is_macro) {
+            result += segment.text;
+        } else if (auto replacement = expand(segment.text)) {
+            result += *replacement;
+        } else {
+            result += '$';
+            result += segment.text;
+            result += '$';
+        }
+    }
     return result;
 }
 
@@ -80,11 +142,12 @@ std::optional<std::string> CustomVariableExpander::expand(
         return {};
     }
 
-    RegExp re(str.substr(_prefix.size()), RegExp::Case::ignore,
-              RegExp::Syntax::literal);
+    // just a case-insensitive comparison, no need to compile a regex per
+    // macro occurrence for that
+    auto wanted = str.substr(_prefix.size());
     for (const auto &[name, value] :
          _mc->customAttributes(&_cvm, AttributeKind::custom_variables)) {
-        if (re.match(name)) {
+        if (strcasecmp(name.c_str(), wanted.c_str()) == 0) {
             return value;
         }
     }
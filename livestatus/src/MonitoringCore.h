@@ -119,6 +119,9 @@ public:
     virtual Encoding dataEncoding() = 0;
     virtual size_t maxResponseSize() = 0;
     virtual size_t maxCachedMessages() = 0;
+    // Upper bound for the estimated memory of cached log messages in bytes,
+    // 0 means "no byte-based limit".
+    virtual size_t maxCachedLogMemory() { return 0; }
 
     [[nodiscard]] virtual ServiceAuthorization serviceAuthorization() const = 0;
     [[nodiscard]] virtual GroupAuthorization groupAuthorization() const = 0;
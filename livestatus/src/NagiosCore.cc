@@ -7,11 +7,15 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <mutex>
 #include <utility>
+#include <variant>
 
 #include "Logger.h"
 #include "NagiosGlobals.h"
 #include "StringUtils.h"
+#include "ValidatedCache.h"
+#include "global_counters.h"
 #include "pnp4nagios.h"
 
 void NagiosPaths::dump(Logger *logger) const {
@@ -38,6 +42,15 @@ NagiosCore::NagiosCore(
     , _authorization(authorization)
     , _data_encoding(data_encoding)
     , _store(this) {
+    // NOTE on reload behavior: a generation-stamped registry with dense IDs
+    // surviving reloads was investigated and rejected. Nagios frees and
+    // reallocates every object on reload and unloads this module with it,
+    // so statics do not survive and every pointer-keyed structure *must* be
+    // rebuilt. What actually fixed the reload freeze is that all derived
+    // state (authorization bitsets, columnar snapshots, group aggregates,
+    // downtime/comment indexes) is now rebuilt lazily on first use and
+    // per-slice instead of upfront: the first query after a reload pays for
+    // what it touches, not for everything.
     for (host *hst = host_list; hst != nullptr; hst = hst->next) {
         if (const char *address = hst->address) {
             _hosts_by_designation[mk::unsafe_tolower(address)] = hst;
@@ -185,6 +198,10 @@ Encoding NagiosCore::dataEncoding() { return _data_encoding; }
 size_t NagiosCore::maxResponseSize() { return _limits._max_response_size; }
 size_t NagiosCore::maxCachedMessages() { return _limits._max_cached_messages; }
 
+size_t NagiosCore::maxCachedLogMemory() {
+    return _limits._max_cached_log_memory;
+}
+
 ServiceAuthorization NagiosCore::serviceAuthorization() const {
     return _authorization._service;
 }
@@ -211,7 +228,7 @@ namespace {
 // space, uses ';' as a comment character, is line-oriented, etc. etc. So we use
 // a base16 encoding for names and values of tags, labels, and label sources,
 // e.g. "48656C6C6F2C20776F726C6421" => "Hello, world!".
-std::string b16decode(const std::string &hex) {
+std::string b16decode_uncached(const std::string &hex) {
     auto len = hex.length() & ~1;
     std::string result;
     result.reserve(len / 2);
@@ -220,6 +237,24 @@ std::string b16decode(const std::string &hex) {
     }
     return result;
 }
+
+// The hex-encoded tag/label names and values are identical across thousands
+// of services (TAG_*, label sets), so the decoded forms are interned in a
+// global pool instead of being re-decoded on every row render. The decode
+// is a pure function, so the validity token is trivial.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+mk::ValidatedCache<std::string, std::string, std::monostate> b16_pool{500000};
+
+// returned by value: a reference into the pool would dangle when eviction
+// drops the entry under a concurrent caller's feet
+std::string b16decode(const std::string &hex) {
+    if (auto decoded = b16_pool.lookup(hex, {})) {
+        return *decoded;
+    }
+    auto decoded = b16decode_uncached(hex);
+    b16_pool.store(hex, {}, decoded);
+    return decoded;
+}
 }  // namespace
 
 Attributes NagiosCore::customAttributes(const void *holder,
@@ -263,38 +298,64 @@ bool NagiosCore::answerRequest(InputBuffer &input, OutputBuffer &output) {
     return _store.answerRequest(input, output);
 }
 
+void NagiosCore::ensureDowntimeCommentIndex() const {
+    auto generation = commentDowntimeGenerationCurrent();
+    if (_dc_index_generation == generation) {
+        return;
+    }
+    _downtimes_by_object.clear();
+    _comments_by_object.clear();
+    for (const auto &[id, dt] : _downtimes) {
+        _downtimes_by_object[{dt->_host, dt->_service}].push_back(dt.get());
+    }
+    for (const auto &[id, co] : _comments) {
+        _comments_by_object[{co->_host, co->_service}].push_back(co.get());
+    }
+    _dc_index_generation = generation;
+}
+
 std::vector<DowntimeData> NagiosCore::downtimes_for_object(
     const ::host *h, const ::service *s) const {
+    std::lock_guard<std::mutex> lg(_dc_index_mutex);
+    ensureDowntimeCommentIndex();
     std::vector<DowntimeData> result;
-    for (const auto &[id, dt] : _downtimes) {
-        if (dt->_host == h && dt->_service == s) {
-            result.push_back({
-                dt->_id,
-                dt->_author_name,
-                dt->_comment,
-                false,
-                dt->_entry_time,
-                dt->_start_time,
-                dt->_end_time,
-                dt->_fixed != 0,
-                dt->_duration,
-                0,
-                dt->_type != 0,
-            });
-        }
+    auto it = _downtimes_by_object.find({h, s});
+    if (it == _downtimes_by_object.end()) {
+        return result;
+    }
+    result.reserve(it->second.size());
+    for (const auto *dt : it->second) {
+        result.push_back({
+            dt->_id,
+            dt->_author_name,
+            dt->_comment,
+            false,
+            dt->_entry_time,
+            dt->_start_time,
+            dt->_end_time,
+            dt->_fixed != 0,
+            dt->_duration,
+            0,
+            dt->_type != 0,
+        });
     }
     return result;
 }
 
 std::vector<CommentData> NagiosCore::comments_for_object(
     const ::host *h, const ::service *s) const {
+    std::lock_guard<std::mutex> lg(_dc_index_mutex);
+    ensureDowntimeCommentIndex();
     std::vector<CommentData> result;
-    for (const auto &[id, co] : _comments) {
-        if (co->_host == h && co->_service == s) {
-            result.push_back({co->_id, co->_author_name, co->_comment,
-                              static_cast<uint32_t>(co->_entry_type),
-                              co->_entry_time});
-        }
+    auto it = _comments_by_object.find({h, s});
+    if (it == _comments_by_object.end()) {
+        return result;
+    }
+    result.reserve(it->second.size());
+    for (const auto *co : it->second) {
+        result.push_back({co->_id, co->_author_name, co->_comment,
+                          static_cast<uint32_t>(co->_entry_type),
+                          co->_entry_time});
     }
     return result;
 }
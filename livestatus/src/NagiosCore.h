@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -47,6 +48,7 @@ struct NagiosPaths {
 
 struct NagiosLimits {
     size_t _max_cached_messages{500000};
+    size_t _max_cached_log_memory{0};  // bytes, 0 = no byte-based limit
     size_t _max_lines_per_logfile{1000000};
     size_t _max_response_size{size_t{100} * 1024 * 1024};
 };
@@ -102,6 +104,7 @@ public:
     Encoding dataEncoding() override;
     size_t maxResponseSize() override;
     size_t maxCachedMessages() override;
+    size_t maxCachedLogMemory() override;
 
     ServiceAuthorization serviceAuthorization() const override;
     GroupAuthorization groupAuthorization() const override;
@@ -128,6 +131,20 @@ public:
     std::map<unsigned long, std::unique_ptr<Downtime>> &_downtimes;
     std::map<unsigned long, std::unique_ptr<Comment>> &_comments;
 
+    // Secondary (host, service) indexes over _downtimes/_comments, rebuilt
+    // lazily when the comment/downtime generation moves: rendering the
+    // downtimes/comments columns for 60k rows against 5k active downtimes
+    // was a linear scan per row before.
+    using object_key = std::pair<const ::host *, const ::service *>;
+    mutable std::mutex _dc_index_mutex;
+    mutable uint64_t _dc_index_generation{0};
+    mutable std::map<object_key, std::vector<const Downtime *>>
+        _downtimes_by_object;
+    mutable std::map<object_key, std::vector<const Comment *>>
+        _comments_by_object;
+
+    void ensureDowntimeCommentIndex() const;
+
 private:
     Logger *_logger_livestatus;
     const NagiosPaths _paths;
@@ -105,6 +105,14 @@ std::optional<std::bitset<32>> OringFilter::valueSetLeastUpperBoundFor(
     return result;
 }
 
+Filter::Cost OringFilter::cost() const {
+    auto result = Cost::cheap;
+    for (const auto &filter : _subfilters) {
+        result = std::max(result, filter->cost());
+    }
+    return result;
+}
+
 std::unique_ptr<Filter> OringFilter::copy() const {
     return make(kind(), disjuncts());
 }
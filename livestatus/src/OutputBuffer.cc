@@ -5,22 +5,201 @@
 
 #include "OutputBuffer.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <chrono>
-#include <cstddef>
+#include <condition_variable>
+#include <mutex>
+#include <cstring>
 #include <iomanip>
-#include <string_view>
+#include <sstream>
 #include <utility>
 
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "FileSystemHelper.h"
 #include "Logger.h"
 #include "POSIXUtils.h"
+#include "Probes.h"
 
 using namespace std::chrono_literals;
 
+namespace {
+// see OutputBuffer::setResponseMemoryLimit
+struct ResponseMemoryGovernor {
+    std::mutex mutex;
+    std::condition_variable freed;
+    size_t limit{0};
+    size_t in_use{0};
+
+    bool acquire(size_t bytes) {
+        std::unique_lock<std::mutex> ul(mutex);
+        if (limit != 0) {
+            // queue instead of OOMing: wait for peers to finish, give up
+            // after a grace period
+            freed.wait_for(ul, std::chrono::seconds(10),
+                           [&] { return in_use + bytes <= limit; });
+            if (in_use + bytes > limit) {
+                return false;
+            }
+        }
+        in_use += bytes;
+        return true;
+    }
+
+    void release(size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lg(mutex);
+            in_use -= bytes;
+        }
+        freed.notify_all();
+    }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+ResponseMemoryGovernor response_memory;
+}  // namespace
+
+// static
+void OutputBuffer::setResponseMemoryLimit(size_t bytes) {
+    std::lock_guard<std::mutex> lg(response_memory.mutex);
+    response_memory.limit = bytes;
+}
+
+// static
+size_t OutputBuffer::responseMemoryInUse() {
+    std::lock_guard<std::mutex> lg(response_memory.mutex);
+    return response_memory.in_use;
+}
+
+OutputBuffer::SegmentChain::SegmentChain() { addSegment(); }
+
+OutputBuffer::SegmentChain::~SegmentChain() {
+    response_memory.release(_segments.size() * _segment_size);
+}
+
+void OutputBuffer::SegmentChain::addSegment() {
+    if (_out_of_memory || !response_memory.acquire(_segment_size)) {
+        // keep the renderer going into a reused scratch segment; the
+        // response is turned into an error on flush
+        _out_of_memory = true;
+        if (_segments.empty()) {
+            {
+                // account the scratch segment
+                std::lock_guard<std::mutex> lg(response_memory.mutex);
+                response_memory.in_use += _segment_size;
+            }
+            _segments.push_back(std::make_unique<char[]>(_segment_size));
+        }
+        auto *base = _segments.back().get();
+        setp(base, base + _segment_size);
+        return;
+    }
+    _segments.push_back(std::make_unique<char[]>(_segment_size));
+    auto *base = _segments.back().get();
+    setp(base, base + _segment_size);
+}
+
+size_t OutputBuffer::SegmentChain::size() const {
+    return (_segments.size() - 1) * _segment_size +
+           static_cast<size_t>(pptr() - pbase());
+}
+
+std::vector<std::string_view> OutputBuffer::SegmentChain::views() const {
+    std::vector<std::string_view> result;
+    result.reserve(_segments.size());
+    for (size_t i = 0; i + 1 < _segments.size(); ++i) {
+        result.emplace_back(_segments[i].get(), _segment_size);
+    }
+    result.emplace_back(pbase(), static_cast<size_t>(pptr() - pbase()));
+    return result;
+}
+
+std::vector<std::string_view> OutputBuffer::SegmentChain::fullSegmentViews()
+    const {
+    std::vector<std::string_view> result;
+    result.reserve(_segments.size() - 1);
+    for (size_t i = 0; i + 1 < _segments.size(); ++i) {
+        result.emplace_back(_segments[i].get(), _segment_size);
+    }
+    return result;
+}
+
+void OutputBuffer::SegmentChain::dropFullSegments() {
+    // Moving the unique_ptrs around does not move the arrays themselves, so
+    // the put area set up for the active segment stays valid. The freed
+    // segments leave the module-wide accounting right here - the
+    // destructor only sees what is still in the chain.
+    response_memory.release((_segments.size() - 1) * _segment_size);
+    _streamed_bytes += (_segments.size() - 1) * _segment_size;
+    _segments.erase(_segments.begin(), _segments.end() - 1);
+}
+
+std::string OutputBuffer::SegmentChain::str() const {
+    std::string result;
+    result.reserve(size());
+    for (const auto &view : views()) {
+        result.append(view.data(), view.size());
+    }
+    return result;
+}
+
+void OutputBuffer::SegmentChain::clear() {
+    response_memory.release(_segments.size() * _segment_size);
+    _segments.clear();
+    _out_of_memory = false;
+    _streamed_bytes = 0;
+    addSegment();
+}
+
+OutputBuffer::SegmentChain::int_type OutputBuffer::SegmentChain::overflow(
+    int_type ch) {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+    }
+    addSegment();
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+std::streamsize OutputBuffer::SegmentChain::xsputn(const char_type *s,
+                                                   std::streamsize count) {
+    std::streamsize remaining = count;
+    while (remaining > 0) {
+        auto room = static_cast<std::streamsize>(epptr() - pptr());
+        if (room == 0) {
+            addSegment();
+            room = static_cast<std::streamsize>(epptr() - pptr());
+        }
+        auto chunk = std::min(remaining, room);
+        std::memcpy(pptr(), s, static_cast<size_t>(chunk));
+        pbump(static_cast<int>(chunk));
+        s += chunk;
+        remaining -= chunk;
+    }
+    return count;
+}
+
+OutputBuffer::SegmentChain::pos_type OutputBuffer::SegmentChain::seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+    if (off == 0 && dir == std::ios_base::cur &&
+        (which & std::ios_base::out) != 0) {
+        return pos_type(static_cast<off_type>(totalSize()));
+    }
+    return pos_type(off_type(-1));
+}
+
 OutputBuffer::OutputBuffer(int fd, std::function<bool()> should_terminate,
                            Logger *logger)
     : _fd(fd)
     , should_terminate_{std::move(should_terminate)}
     , _logger(logger)
+    , _os(&_buf)
     // TODO(sp) This is really the wrong default because it hides some early
     // errors, e.g. an unknown command. But we can't change this easily because
     // of legacy reasons... :-/
@@ -29,39 +208,195 @@ OutputBuffer::OutputBuffer(int fd, std::function<bool()> should_terminate,
 
 OutputBuffer::~OutputBuffer() { flush(); }
 
+namespace {
+// the one directory response files may live in; empty = feature disabled
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex response_file_directory_mutex;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::string response_file_directory;
+}  // namespace
+
+// static
+void OutputBuffer::setResponseFileDirectory(std::string directory) {
+    std::lock_guard<std::mutex> lg(response_file_directory_mutex);
+    response_file_directory = std::move(directory);
+}
+
 void OutputBuffer::flush() {
+    if (!_response_file.empty()) {
+        // canonical containment check: rejects anything outside the
+        // configured directory, including symlink and dot-dot escapes
+        std::string directory;
+        {
+            std::lock_guard<std::mutex> lg(response_file_directory_mutex);
+            directory = response_file_directory;
+        }
+        if (directory.empty() ||
+            !mk::path_contains(directory, _response_file)) {
+            Warning(_logger) << "refusing response file '" << _response_file
+                             << "', not within the configured "
+                                "response_file_directory";
+            _response_file.clear();
+        }
+    }
+    if (_buf.outOfMemory()) {
+        setError(ResponseCode::payload_too_large,
+                 "livestatus response memory exhausted, try again later");
+        _buf.clear();
+        _os << _error_message;
+    }
+    if (!_response_file.empty() && _response_code == ResponseCode::ok) {
+        auto buffers = _buf.views();
+        std::string compressed;
+        maybeCompress(buffers, compressed);
+        // Refuse to create files or follow symlinks: the client prepares
+        // the file, we only fill it.
+        int fd = ::open(_response_file.c_str(), O_WRONLY | O_NOFOLLOW);
+        if (fd >= 0) {
+            size_t size{0};
+            for (const auto &buffer : buffers) {
+                size += buffer.size();
+            }
+            bool ok = ::ftruncate(fd, static_cast<off_t>(size)) == 0 &&
+                      writevWithTimeoutWhile(fd, std::move(buffers), 100ms,
+                                             [this]() {
+                                                 return !shouldTerminate();
+                                             }) != -1;
+            ::close(fd);
+            if (ok) {
+                // only the completion header goes over the socket
+                std::ostringstream header;
+                header << std::setw(3) << std::setfill('0')
+                       << static_cast<unsigned>(_response_code) << " "
+                       << std::setw(11) << std::setfill(' ') << size << "\n";
+                auto header_str = header.str();
+                writeData({std::string_view{header_str}});
+                return;
+            }
+        }
+        generic_error ge{"cannot write response file " + _response_file};
+        Informational(_logger) << ge;
+        // fall through to the normal socket response
+    }
     if (_response_header == ResponseHeader::fixed16) {
         if (_response_code != ResponseCode::ok) {
-            _os.clear();
-            _os.str("");
+            _buf.clear();
             _os << _error_message;
         }
+        auto buffers = _buf.views();
+        std::string compressed;
+        maybeCompress(buffers, compressed);
+        size_t size{0};
+        for (const auto &buffer : buffers) {
+            size += buffer.size();
+        }
         auto code = static_cast<unsigned>(_response_code);
-        size_t size = _os.tellp();
         std::ostringstream header;
         header << std::setw(3) << std::setfill('0') << code << " "  //
                << std::setw(11) << std::setfill(' ') << size << "\n";
-        writeData(header);
+        auto header_str = header.str();
+        buffers.insert(buffers.begin(), std::string_view{header_str});
+        writeData(std::move(buffers));
+        return;
     }
-    writeData(_os);
+    if (_response_header == ResponseHeader::chunked) {
+        if (_response_code != ResponseCode::ok && !_chunks_streamed) {
+            // Nothing has left the process yet, so we can still turn the
+            // whole response into an error. Later errors can only be
+            // signalled via the code in the terminating chunk header.
+            _buf.clear();
+            _os << _error_message;
+        }
+        if (_buf.size() > 0) {
+            writeChunk(_buf.views());
+        }
+        // terminating zero-length chunk
+        writeChunk({});
+        return;
+    }
+    auto buffers = _buf.views();
+    std::string compressed;
+    maybeCompress(buffers, compressed);
+    writeData(std::move(buffers));
 }
 
-namespace {
-// TODO(sp) This cruel and slightly non-portable hack avoids copying, which
-// is important. Note that UBSan rightly complains about it. We could do
-// better with C++20 via os.view().
-std::string_view toStringView(std::ostringstream &os) {
-    struct Hack : public std::stringbuf {
-        [[nodiscard]] const char *base() const { return pbase(); }
-    };
-    return {static_cast<Hack *>(os.rdbuf())->base(),
-            static_cast<size_t>(os.tellp())};
+void OutputBuffer::tryFlushChunk() {
+    if (_response_header != ResponseHeader::chunked) {
+        return;
+    }
+    auto buffers = _buf.fullSegmentViews();
+    if (buffers.empty()) {
+        return;
+    }
+    writeChunk(std::move(buffers));
+    _buf.dropFullSegments();
+    _chunks_streamed = true;
 }
-}  // namespace
 
-void OutputBuffer::writeData(std::ostringstream &os) {
-    if (writeWithTimeoutWhile(_fd, toStringView(os), 100ms,
-                              [this]() { return !shouldTerminate(); }) == -1) {
+void OutputBuffer::writeChunk(std::vector<std::string_view> buffers) {
+    std::string compressed;
+    maybeCompress(buffers, compressed);
+    size_t size{0};
+    for (const auto &buffer : buffers) {
+        size += buffer.size();
+    }
+    auto code = static_cast<unsigned>(_response_code);
+    std::ostringstream header;
+    header << std::setw(3) << std::setfill('0') << code << " "  //
+           << std::setw(11) << std::setfill(' ') << size << "\n";
+    auto header_str = header.str();
+    buffers.insert(buffers.begin(), std::string_view{header_str});
+    writeData(std::move(buffers));
+}
+
+#ifdef HAVE_ZSTD
+// static
+bool OutputBuffer::supportsZstd() { return true; }
+
+void OutputBuffer::maybeCompress(std::vector<std::string_view> &buffers,
+                                 std::string &storage) {
+    if (_compression != Compression::zstd || buffers.empty()) {
+        return;
+    }
+    size_t size{0};
+    for (const auto &buffer : buffers) {
+        size += buffer.size();
+    }
+    // One-shot compression of the (typically highly redundant) payload into
+    // a single zstd frame. In chunked mode every chunk is its own frame, so
+    // clients can decompress while the response is still streaming.
+    std::string input;
+    input.reserve(size);
+    for (const auto &buffer : buffers) {
+        input.append(buffer.data(), buffer.size());
+    }
+    storage.resize(ZSTD_compressBound(size));
+    auto ret = ZSTD_compress(storage.data(), storage.size(), input.data(),
+                             input.size(), ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(ret) != 0U) {
+        Warning(_logger) << "cannot compress response: "
+                         << ZSTD_getErrorName(ret);
+        return;  // fall back to the uncompressed payload
+    }
+    storage.resize(ret);
+    buffers.assign({std::string_view{storage}});
+}
+#else
+// static
+bool OutputBuffer::supportsZstd() { return false; }
+
+void OutputBuffer::maybeCompress(std::vector<std::string_view> & /*buffers*/,
+                                 std::string & /*storage*/) {}
+#endif
+
+void OutputBuffer::writeData(std::vector<std::string_view> buffers) {
+    size_t total{0};
+    for (const auto &buffer : buffers) {
+        total += buffer.size();
+    }
+    LIVESTATUS_PROBE1(response_flush, total);
+    if (writevWithTimeoutWhile(_fd, std::move(buffers), 100ms,
+                               [this]() { return !shouldTerminate(); }) == -1) {
         generic_error ge{"cannot write to client socket"};
         Informational(_logger) << ge;
     }
@@ -8,9 +8,14 @@
 
 #include "config.h"  // IWYU pragma: keep
 
+#include <cstddef>
 #include <functional>
-#include <sstream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <vector>
 class Logger;
 
 class OutputBuffer {
@@ -28,7 +33,9 @@ public:
         bad_gateaway = 502,
     };
 
-    enum class ResponseHeader { off, fixed16 };
+    enum class ResponseHeader { off, fixed16, chunked };
+
+    enum class Compression { off, zstd };
 
     OutputBuffer(int fd, std::function<bool()> should_terminate,
                  Logger *logger);
@@ -37,26 +44,113 @@ public:
     bool shouldTerminate() const { return should_terminate_(); }
 
     std::ostream &os() { return _os; }
-    std::string str() const { return _os.str(); }
+    std::string str() const { return _buf.str(); }
 
     void setResponseHeader(ResponseHeader r) { _response_header = r; }
+    ResponseHeader responseHeader() const { return _response_header; }
+
+    void setCompression(Compression c) { _compression = c; }
+
+    /// Shared-memory style response channel: the rendered payload is written
+    /// into the given file (typically on /dev/shm, pre-created by the local
+    /// client) and the socket only carries the fixed16 completion header
+    /// with the payload size. Removes the socket throughput cap for
+    /// multi-megabyte snapshots pulled by local clients.
+    ///
+    /// The feature is off unless the module config names an allowed
+    /// directory (see setResponseFileDirectory): any client with socket
+    /// access can send this header, and without the fence it could make
+    /// the module truncate arbitrary files writable by the site user.
+    void setResponseFile(std::string path) {
+        _response_file = std::move(path);
+    }
+    static void setResponseFileDirectory(std::string directory);
+    /// Whether this build was made with zstd support.
+    static bool supportsZstd();
+
+    /// In chunked mode, stream out any completely filled segments as a
+    /// length-prefixed chunk; a no-op in the other response header modes.
+    /// Called at row boundaries, so big responses leave the process while
+    /// they are still being produced and resident memory stays bounded.
+    void tryFlushChunk();
 
     void setError(ResponseCode code, const std::string &message);
     std::string getError() const;
 
     Logger *getLogger() const { return _logger; }
 
+    /// Module-wide governor for response buffer memory: when the sum of all
+    /// live response segments would exceed the limit, an allocating query
+    /// first waits for memory to be freed and is failed with an error
+    /// response if none shows up - log-query storms used to drive the whole
+    /// Nagios process into swap instead. 0 means unlimited.
+    static void setResponseMemoryLimit(size_t bytes);
+    static size_t responseMemoryInUse();
+
 private:
+    // The response is accumulated in a chain of fixed-size segments instead
+    // of one contiguous stringstream: a 200MB "GET log" response would
+    // otherwise need a giant allocation plus full copies on every growth and
+    // again on output. The segments are handed to writev() as they are,
+    // without any copying.
+    class SegmentChain : public std::streambuf {
+    public:
+        SegmentChain();
+        ~SegmentChain() override;
+        [[nodiscard]] bool outOfMemory() const { return _out_of_memory; }
+        /// bytes currently resident in the chain
+        [[nodiscard]] size_t size() const;
+        /// resident plus already streamed-out bytes: what tellp() reports,
+        /// so size accounting and the response size limit keep seeing the
+        /// whole response in chunked mode
+        [[nodiscard]] size_t totalSize() const {
+            return _streamed_bytes + size();
+        }
+        [[nodiscard]] std::vector<std::string_view> views() const;
+        [[nodiscard]] std::vector<std::string_view> fullSegmentViews() const;
+        void dropFullSegments();
+        [[nodiscard]] std::string str() const;
+        void clear();
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char_type *s,
+                               std::streamsize count) override;
+        // Just enough to keep os().tellp() working for size accounting.
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) override;
+
+    private:
+        static constexpr size_t _segment_size = 65536;
+        std::vector<std::unique_ptr<char[]>> _segments;
+        // set when the module-wide response memory budget was exhausted;
+        // further output is discarded into a scratch segment and flush()
+        // turns the response into an error
+        bool _out_of_memory{false};
+        // bytes dropped from the chain by dropFullSegments() after they
+        // were streamed out in chunked mode
+        size_t _streamed_bytes{0};
+
+        void addSegment();
+    };
+
     const int _fd;
     const std::function<bool()> should_terminate_;
     Logger *const _logger;
-    std::ostringstream _os;
+    SegmentChain _buf;
+    std::ostream _os;
     ResponseHeader _response_header;
+    Compression _compression{Compression::off};
+    std::string _response_file;
     ResponseCode _response_code;
     std::string _error_message;
+    bool _chunks_streamed{false};
 
     void flush();
-    void writeData(std::ostringstream &os);
+    void maybeCompress(std::vector<std::string_view> &buffers,
+                       std::string &storage);
+    void writeChunk(std::vector<std::string_view> buffers);
+    void writeData(std::vector<std::string_view> buffers);
 };
 
 #endif  // OutputBuffer_h
@@ -13,8 +13,10 @@
 
 #include "POSIXUtils.h"
 
+#include <limits.h>
 #include <pthread.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <ratio>
@@ -210,3 +212,50 @@ ssize_t writeWithTimeout(int fd, std::string_view buffer,
                          std::chrono::nanoseconds timeout) {
     return writeWithTimeoutWhile(fd, buffer, timeout, []() { return true; });
 }
+
+namespace {
+// Keep the iovec array small and on the stack; IOV_MAX is typically 1024,
+// which would be 16kB of iovecs.
+constexpr int max_iov = 64;
+}  // namespace
+
+ssize_t writevWithTimeoutWhile(int fd, std::vector<std::string_view> buffers,
+                               std::chrono::nanoseconds timeout,
+                               const std::function<bool()> &pred) {
+    ssize_t size{0};
+    for (const auto &buffer : buffers) {
+        size += buffer.size();
+    }
+    size_t current{0};
+    while (current < buffers.size() && pred()) {
+        std::array<iovec, max_iov> iov{};
+        int count{0};
+        for (size_t i = current; i < buffers.size() && count < max_iov; ++i) {
+            // NOTE: writev() does not modify the buffers, the non-const
+            // iov_base is a POSIX wart.
+            iov[count].iov_base = const_cast<char *>(buffers[i].data());
+            iov[count].iov_len = buffers[i].size();
+            ++count;
+        }
+        auto ret = ::writev(fd, iov.data(), count);
+        if (ret == -1 && errno == EWOULDBLOCK) {
+            ret = Poller{}.wait(timeout, fd, PollEvents::out)
+                      ? ::writev(fd, iov.data(), count)
+                      : -1;
+        }
+        if (ret != -1) {
+            auto written = static_cast<size_t>(ret);
+            while (current < buffers.size() &&
+                   written >= buffers[current].size()) {
+                written -= buffers[current].size();
+                ++current;
+            }
+            if (current < buffers.size()) {
+                buffers[current].remove_prefix(written);
+            }
+        } else if (errno != EINTR) {
+            return -1;
+        }
+    }
+    return size;
+}
@@ -20,6 +20,7 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 class Logger;
 
 class SocketPair {
@@ -143,4 +144,8 @@ ssize_t writeWithTimeoutWhile(int fd, std::string_view buffer,
 ssize_t writeWithTimeout(int fd, std::string_view buffer,
                          std::chrono::nanoseconds timeout);
 
+ssize_t writevWithTimeoutWhile(int fd, std::vector<std::string_view> buffers,
+                               std::chrono::nanoseconds timeout,
+                               const std::function<bool()> &pred);
+
 #endif  // POSIXUtils_h
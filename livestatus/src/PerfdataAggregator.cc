@@ -5,30 +5,59 @@
 
 #include "PerfdataAggregator.h"
 
+#include <charconv>
 #include <cmath>
-#include <iterator>
-#include <sstream>
-#include <stdexcept>
+#include <string_view>
 #include <type_traits>
 
 #include "Renderer.h"
 #include "Row.h"
 
+// NOTE: A cache of parsed perfdata strings was considered here and
+// deliberately rejected: the values change with every check result, so the
+// hit rate across queries is near zero, and a shared cache would put a lock
+// into the stats path which now runs on a worker pool. Parsing the string
+// without streams, substrings and exceptions is where the time actually
+// goes.
 void PerfdataAggregator::consume(Row row, const contact * /* auth_user */,
                                  std::chrono::seconds /* timezone_offset */) {
-    std::istringstream iss(_getValue(row));
-    std::istream_iterator<std::string> end;
-    for (auto it = std::istream_iterator<std::string>(iss); it != end; ++it) {
-        auto pos = it->find('=');
-        if (pos != std::string::npos) {
-            try {
-                auto varname = it->substr(0, pos);
-                auto value = std::stod(it->substr(pos + 1));
-                _aggregations.insert(std::make_pair(varname, _factory()))
-                    .first->second->update(value);
-            } catch (const std::logic_error &e) {
-            }
+    auto perf_data = _getValue(row);
+    std::string_view rest{perf_data};
+    while (!rest.empty()) {
+        auto space = rest.find(' ');
+        auto token = rest.substr(0, space);
+        rest.remove_prefix(space == std::string_view::npos ? rest.size()
+                                                           : space + 1);
+        auto eq = token.find('=');
+        if (eq == std::string_view::npos) {
+            continue;
+        }
+        auto value_str = token.substr(eq + 1);
+        double value = 0;
+        auto [ptr, ec] = std::from_chars(
+            value_str.data(), value_str.data() + value_str.size(), value);
+        // trailing units like "ms" or ";10;20" are fine, they just end the
+        // number; a token without any digits is skipped like before
+        if (ec != std::errc{} || ptr == value_str.data()) {
+            continue;
+        }
+        auto varname = std::string{token.substr(0, eq)};
+        auto it = _aggregations.find(varname);
+        if (it == _aggregations.end()) {
+            it = _aggregations.emplace(std::move(varname), _factory()).first;
+        }
+        it->second->update(value);
+    }
+}
+
+void PerfdataAggregator::combine(const Aggregator &other) {
+    const auto &rhs = static_cast<const PerfdataAggregator &>(other);
+    for (const auto &[varname, aggregation] : rhs._aggregations) {
+        auto it = _aggregations.find(varname);
+        if (it == _aggregations.end()) {
+            it = _aggregations.emplace(varname, _factory()).first;
         }
+        it->second->combine(*aggregation);
     }
 }
 
@@ -28,6 +28,7 @@ public:
         : _factory(std::move(factory)), _getValue{std::move(getValue)} {}
     void consume(Row row, const contact *auth_user,
                  std::chrono::seconds timezone_offset) override;
+    void combine(const Aggregator &other) override;
     void output(RowRenderer &r) const override;
 
 private:
@@ -15,7 +15,6 @@
 #include <cerrno>
 #include <chrono>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "BitMask.h"
@@ -92,8 +91,7 @@ public:
     }
 
     void addFileDescriptor(int fd, PollEvents e) {
-        assert(_fd_to_pollfd.find(fd) == std::cend(_fd_to_pollfd));
-        _fd_to_pollfd[fd] = _pollfds.size();
+        assert(find(fd) == nullptr);
         _pollfds.push_back({fd, toMask(e), 0});
     }
 
@@ -104,9 +102,8 @@ public:
     }
 
     bool isFileDescriptorSet(int fd, PollEvents e) const {
-        auto it = _fd_to_pollfd.find(fd);
-        return it != _fd_to_pollfd.end() &&
-               (_pollfds[it->second].revents & toMask(e)) != 0;
+        const auto *entry = find(fd);
+        return entry != nullptr && (entry->revents & toMask(e)) != 0;
     }
 
     template <class Protocol, class SocketService>
@@ -120,8 +117,20 @@ private:
     friend class PollerFixture_ToMask_Test;       // CONTEXT: Google-Fuchsia
     friend class PollerFixture_Descriptors_Test;  // whitebox style testing
 
+    // NOTE: A Poller instance typically watches one or two file
+    // descriptors for the duration of a single wait, so a linear scan beats
+    // any map - the hash map used before cost an allocation on every
+    // read/write wait of every connection.
     std::vector<pollfd> _pollfds;
-    std::unordered_map<int, size_t> _fd_to_pollfd;
+
+    [[nodiscard]] const pollfd *find(int fd) const {
+        for (const auto &entry : _pollfds) {
+            if (entry.fd == fd) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
 
     static short toMask(PollEvents e) {
         // The cast below is OK because all POLLFOO values are within the
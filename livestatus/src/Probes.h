@@ -0,0 +1,38 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#ifndef Probes_h
+#define Probes_h
+
+#include "config.h"  // IWYU pragma: keep
+
+// USDT static tracepoints for the livestatus hot paths: zero overhead when
+// nobody traces (a single nop per site), attachable from perf/bpftrace as
+//
+//     bpftrace -e 'usdt:/omd/.../livestatus.o:livestatus:query_done
+//                  { @us = hist(arg1); }'
+//
+// Falls back to no-ops when the systemtap sdt header is not installed.
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define HAVE_SYS_SDT_H 1
+#endif
+#endif
+
+#ifdef HAVE_SYS_SDT_H
+#define LIVESTATUS_PROBE(name) DTRACE_PROBE(livestatus, name)
+#define LIVESTATUS_PROBE1(name, a) DTRACE_PROBE1(livestatus, name, a)
+#define LIVESTATUS_PROBE2(name, a, b) DTRACE_PROBE2(livestatus, name, a, b)
+#define LIVESTATUS_PROBE3(name, a, b, c) \
+    DTRACE_PROBE3(livestatus, name, a, b, c)
+#else
+#define LIVESTATUS_PROBE(name)
+#define LIVESTATUS_PROBE1(name, a)
+#define LIVESTATUS_PROBE2(name, a, b)
+#define LIVESTATUS_PROBE3(name, a, b, c)
+#endif
+
+#endif  // Probes_h
@@ -6,6 +6,7 @@
 #include "Query.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cctype>
 #include <cmath>
@@ -13,6 +14,7 @@
 #include <ratio>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <type_traits>
 
 #include "Aggregator.h"
@@ -24,6 +26,8 @@
 #include "NullColumn.h"
 #include "OringFilter.h"
 #include "OutputBuffer.h"
+#include "Probes.h"
+#include "QueryStats.h"
 #include "StringUtils.h"
 #include "Table.h"
 #include "auth.h"
@@ -60,10 +64,21 @@ void checkNoArguments(const char *line) {
 }
 }  // namespace
 
+namespace {
+// 64kB of per-worker scratch backing every Query's arena: a keep-alive
+// connection issues hundreds of queries whose parse-time allocations are
+// the same sizes every time. The buffer persists across requests (cleared,
+// not freed, by each Query's arena release), so those allocations become
+// pointer bumps without any malloc; only oversized queries spill to the
+// heap. Safe because each worker thread runs exactly one Query at a time.
+thread_local std::array<char, 65536> query_scratch;
+}  // namespace
+
 Query::Query(const std::list<std::string> &lines, Table &table,
              Encoding data_encoding, size_t max_response_size,
              OutputBuffer &output, Logger *logger)
-    : _data_encoding(data_encoding)
+    : _arena{query_scratch.data(), query_scratch.size()}
+    , _data_encoding(data_encoding)
     , _max_response_size(max_response_size)
     , _output(output)
     , _renderer_query(nullptr)
@@ -79,7 +94,12 @@ Query::Query(const std::list<std::string> &lines, Table &table,
     , _limit(-1)
     , _current_line(0)
     , _timezone_offset(0)
-    , _logger(logger) {
+    , _logger(logger)
+    , _columns{&_arena}
+    , _stats_columns{&_arena}
+    , _stats_groups{&_arena}
+    , _stats_groups_index{&_arena}
+    , _all_columns{&_arena} {
     FilterStack filters;
     FilterStack wait_conditions;
     for (const auto &line : lines) {
@@ -126,6 +146,14 @@ Query::Query(const std::list<std::string> &lines, Table &table,
                 parseColumnHeadersLine(arguments);
             } else if (header == "Limit") {
                 parseLimitLine(arguments);
+            } else if (header == "OrderBy") {
+                parseOrderByLine(arguments);
+            } else if (header == "Cursor") {
+                parseCursorLine(arguments);
+            } else if (header == "Debug") {
+                parseDebugLine(arguments);
+            } else if (header == "ResponseFile") {
+                parseResponseFileLine(arguments);
             } else if (header == "Timelimit") {
                 parseTimelimitLine(arguments);
             } else if (header == "AuthUser") {
@@ -136,6 +164,8 @@ Query::Query(const std::list<std::string> &lines, Table &table,
                 parseOutputFormatLine(arguments);
             } else if (header == "ResponseHeader") {
                 parseResponseHeaderLine(arguments);
+            } else if (header == "Compress") {
+                parseCompressLine(arguments);
             } else if (header == "KeepAlive") {
                 parseKeepAliveLine(arguments);
             } else if (header == "WaitCondition") {
@@ -257,6 +287,9 @@ namespace {
 class SumAggregation : public Aggregation {
 public:
     void update(double value) override { sum_ += value; }
+    void combine(const Aggregation &other) override {
+        sum_ += static_cast<const SumAggregation &>(other).sum_;
+    }
     [[nodiscard]] double value() const override { return sum_; }
 
 private:
@@ -272,6 +305,13 @@ public:
         first_ = false;
     }
 
+    void combine(const Aggregation &other) override {
+        const auto &rhs = static_cast<const MinAggregation &>(other);
+        if (!rhs.first_) {
+            update(rhs.sum_);
+        }
+    }
+
     [[nodiscard]] double value() const override { return sum_; }
 
 private:
@@ -290,6 +330,13 @@ public:
         first_ = false;
     }
 
+    void combine(const Aggregation &other) override {
+        const auto &rhs = static_cast<const MaxAggregation &>(other);
+        if (!rhs.first_) {
+            update(rhs.sum_);
+        }
+    }
+
     [[nodiscard]] double value() const override { return sum_; }
 
 private:
@@ -306,6 +353,12 @@ public:
         sum_ += value;
     }
 
+    void combine(const Aggregation &other) override {
+        const auto &rhs = static_cast<const AvgAggregation &>(other);
+        count_ += rhs.count_;
+        sum_ += rhs.sum_;
+    }
+
     [[nodiscard]] double value() const override { return sum_ / count_; }
 
 private:
@@ -321,6 +374,13 @@ public:
         sum_of_squares_ += value * value;
     }
 
+    void combine(const Aggregation &other) override {
+        const auto &rhs = static_cast<const StdAggregation &>(other);
+        count_ += rhs.count_;
+        sum_ += rhs.sum_;
+        sum_of_squares_ += rhs.sum_of_squares_;
+    }
+
     [[nodiscard]] double value() const override {
         auto mean = sum_ / count_;
         return sqrt(sum_of_squares_ / count_ - mean * mean);
@@ -335,6 +395,9 @@ private:
 class SumInvAggregation : public Aggregation {
 public:
     void update(double value) override { sum_ += 1.0 / value; }
+    void combine(const Aggregation &other) override {
+        sum_ += static_cast<const SumInvAggregation &>(other).sum_;
+    }
     [[nodiscard]] double value() const override { return sum_; }
 
 private:
@@ -348,6 +411,12 @@ public:
         sum_ += 1.0 / value;
     }
 
+    void combine(const Aggregation &other) override {
+        const auto &rhs = static_cast<const AvgInvAggregation &>(other);
+        count_ += rhs.count_;
+        sum_ += rhs.sum_;
+    }
+
     [[nodiscard]] double value() const override { return sum_ / count_; }
 
 private:
@@ -460,7 +529,8 @@ const std::map<std::string, OutputFormat> formats{
     {"csv", OutputFormat::broken_csv},
     {"json", OutputFormat::json},
     {"python", OutputFormat::python},
-    {"python3", OutputFormat::python3}};
+    {"python3", OutputFormat::python3},
+    {"binary_columnar", OutputFormat::binary_columnar}};
 }  // namespace
 
 void Query::parseOutputFormatLine(const char *line) {
@@ -509,8 +579,25 @@ void Query::parseResponseHeaderLine(char *line) {
         _output.setResponseHeader(OutputBuffer::ResponseHeader::off);
     } else if (value == "fixed16") {
         _output.setResponseHeader(OutputBuffer::ResponseHeader::fixed16);
+    } else if (value == "chunked") {
+        _output.setResponseHeader(OutputBuffer::ResponseHeader::chunked);
+    } else {
+        throw std::runtime_error("expected 'off', 'fixed16' or 'chunked'");
+    }
+}
+
+void Query::parseCompressLine(char *line) {
+    auto value = nextStringArgument(&line);
+    if (value == "off") {
+        _output.setCompression(OutputBuffer::Compression::off);
+    } else if (value == "zstd") {
+        if (!OutputBuffer::supportsZstd()) {
+            throw std::runtime_error(
+                "this installation does not support zstd compression");
+        }
+        _output.setCompression(OutputBuffer::Compression::zstd);
     } else {
-        throw std::runtime_error("expected 'off' or 'fixed16'");
+        throw std::runtime_error("expected 'off' or 'zstd'");
     }
 }
 
@@ -518,6 +605,41 @@ void Query::parseLimitLine(char *line) {
     _limit = nextNonNegativeIntegerArgument(&line);
 }
 
+void Query::parseResponseFileLine(char *line) {
+    auto value = nextStringArgument(&line);
+    _output.setResponseFile(value);
+}
+
+void Query::parseDebugLine(char *line) {
+    auto value = nextStringArgument(&line);
+    if (value == "plan") {
+        _debug_plan = true;
+    } else {
+        throw std::runtime_error("expected 'plan'");
+    }
+}
+
+void Query::parseCursorLine(char *line) {
+    auto value = nextStringArgument(&line);
+    _cursor = value;
+}
+
+void Query::parseOrderByLine(char *line) {
+    auto column_name = nextStringArgument(&line);
+    std::string direction{"asc"};
+    if (auto *value = next_field(&line)) {
+        direction = value;
+    }
+    if (direction == "asc") {
+        _order_by_desc = false;
+    } else if (direction == "desc") {
+        _order_by_desc = true;
+    } else {
+        throw std::runtime_error("expected 'asc' or 'desc'");
+    }
+    _order_by = _table.column(column_name);
+}
+
 void Query::parseTimelimitLine(char *line) {
     auto duration = std::chrono::seconds{nextNonNegativeIntegerArgument(&line)};
     _time_limit = {duration, std::chrono::steady_clock::now() + duration};
@@ -570,8 +692,30 @@ void Query::parseLocaltimeLine(char *line) {
 
 bool Query::doStats() const { return !_stats_columns.empty(); }
 
+// Measured and rejected - a scan/render pipeline: splitting
+// processDataset into a scan thread and a render thread behind an SPSC
+// queue was evaluated after the other scan work landed and dropped on
+// measurement grounds: filtering now prefilters via the columnar snapshots and
+// renders through vectorized escaping and to_chars numerics, so the two
+// stages no longer have comparable costs to overlap - the queue handoff
+// per row would cost a significant fraction of what rendering a row
+// costs. Large aggregations already parallelize via the stats worker
+// pool.
 bool Query::process() {
     // Precondition: output has been reset
+    if (_debug_plan) {
+        // "Debug: plan" lets clients see what the engine actually does with
+        // their query, without raising the global log level: the normalized
+        // filter tree here, the bound/index decisions as the tables log
+        // them, and the volume/timing figures after the run.
+        Notice logger{_logger};
+        logger << "plan: table=" << _table.name() << " limit=" << _limit
+               << " filter={" << *_filter << "}";
+        if (!_wait_condition->is_tautology()) {
+            logger << " wait_condition={" << *_wait_condition << "}";
+        }
+    }
+    LIVESTATUS_PROBE1(query_start, _table.name().c_str());
     auto start_time = std::chrono::system_clock::now();
     auto renderer =
         Renderer::make(_output_format, _output.os(), _output.getLogger(),
@@ -583,11 +727,36 @@ bool Query::process() {
     start(q);
     _table.answerQuery(this);
     finish(q);
-    auto elapsed_ms = mk::ticks<std::chrono::milliseconds>(
-        std::chrono::system_clock::now() - start_time);
+    auto elapsed = std::chrono::system_clock::now() - start_time;
+    auto elapsed_ms = mk::ticks<std::chrono::milliseconds>(elapsed);
+    auto bytes_sent = static_cast<uint64_t>(_output.os().tellp());
     Informational(_logger) << "processed request in " << elapsed_ms
-                           << " ms, replied with " << _output.os().tellp()
-                           << " bytes";
+                           << " ms, replied with " << bytes_sent << " bytes";
+    LIVESTATUS_PROBE3(query_done,
+                      std::chrono::duration_cast<std::chrono::microseconds>(
+                          elapsed)
+                          .count(),
+                      _rows_scanned, bytes_sent);
+    QueryStats::instance().record(
+        {start_time,
+         std::chrono::duration_cast<std::chrono::microseconds>(elapsed),
+         _table.name(), _rows_scanned, _current_line, bytes_sent});
+    if (_debug_plan) {
+        Notice(_logger) << "plan: duration=" << elapsed_ms << "ms"
+                        << " rows_scanned=" << _rows_scanned
+                        << " rows_emitted=" << _current_line
+                        << " bytes_sent=" << bytes_sent;
+    }
+    auto threshold = QueryStats::instance().slowQueryThreshold();
+    if (threshold > 0ms && elapsed >= threshold) {
+        Warning(_logger) << "slow query: table=" << _table.name()
+                         << " duration=" << elapsed_ms << "ms"
+                         << " rows_scanned=" << _rows_scanned
+                         << " rows_emitted=" << _current_line
+                         << " bytes_sent=" << bytes_sent
+                         << " limit=" << _limit << " filter={" << *_filter
+                         << "}";
+    }
     return _keepalive;
 }
 
@@ -612,6 +781,15 @@ bool Query::timelimitReached() const {
     if (!_time_limit) {
         return false;
     }
+    // Reading the clock for every processed row shows up in profiles of
+    // full-table scans, so the check is decimated: the deadline is only
+    // consulted every 128 rows. With microsecond-ish row costs that bounds
+    // the overshoot to well under a millisecond while making the per-row
+    // cost a counter decrement.
+    if (--_timelimit_check_countdown > 0) {
+        return false;
+    }
+    _timelimit_check_countdown = timelimit_check_interval;
     const auto &[duration, timeout] = *_time_limit;
     if (std::chrono::steady_clock::now() >= timeout) {
         _output.setError(
@@ -624,7 +802,86 @@ bool Query::timelimitReached() const {
     return false;
 }
 
+namespace {
+constexpr size_t min_rows_per_thread = 8192;
+
+size_t statsWorkerCountFor(size_t num_rows) {
+    return std::min(
+        {num_rows / min_rows_per_thread,
+         static_cast<size_t>(std::max(1U, std::thread::hardware_concurrency())),
+         size_t{16}});
+}
+}  // namespace
+
+bool Query::wantsParallelStats(size_t num_rows) const {
+    return doStats() && _columns.empty() && _limit < 0 && !_time_limit &&
+           statsWorkerCountFor(num_rows) >= 2;
+}
+
+bool Query::processStatsDatasetsParallel(const std::vector<Row> &rows) {
+    auto num_threads = statsWorkerCountFor(rows.size());
+    if (!wantsParallelStats(rows.size())) {
+        return false;
+    }
+
+    // one private set of aggregators per worker
+    std::vector<std::vector<std::unique_ptr<Aggregator>>> partials(
+        num_threads);
+    for (auto &aggrs : partials) {
+        aggrs.reserve(_stats_columns.size());
+        for (const auto &sc : _stats_columns) {
+            aggrs.push_back(sc->createAggregator(_logger));
+        }
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    auto chunk = (rows.size() + num_threads - 1) / num_threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        workers.emplace_back([this, &rows, &partials, t, chunk]() {
+            auto begin = t * chunk;
+            auto end = std::min(rows.size(), begin + chunk);
+            auto &aggrs = partials[t];
+            // filter the whole chunk first: each subfilter is dispatched
+            // once per chunk and runs a tight loop over its column
+            std::vector<Row> chunk_rows{rows.begin() + begin,
+                                        rows.begin() + end};
+            std::vector<char> accepted(chunk_rows.size(), 1);
+            _filter->acceptsBatch(chunk_rows, accepted, _auth_user,
+                                  _timezone_offset);
+            for (size_t i = 0; i < chunk_rows.size(); ++i) {
+                if (_output.shouldTerminate()) {
+                    return;
+                }
+                if (accepted[i] == 0) {
+                    continue;
+                }
+                Row row = chunk_rows[i];
+                if (_auth_user == no_auth_user() ||
+                    _table.isAuthorized(row, _auth_user)) {
+                    for (const auto &aggr : aggrs) {
+                        aggr->consume(row, _auth_user, _timezone_offset);
+                    }
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    _rows_scanned += rows.size();
+    const auto &aggregators = getAggregatorsFor({});
+    for (const auto &partial : partials) {
+        for (size_t i = 0; i < aggregators.size(); ++i) {
+            aggregators[i]->combine(*partial[i]);
+        }
+    }
+    return true;
+}
+
 bool Query::processDataset(Row row) {
+    ++_rows_scanned;
     if (_output.shouldTerminate()) {
         // Not the perfect response code, but good enough...
         _output.setError(OutputBuffer::ResponseCode::payload_too_large,
@@ -643,6 +900,19 @@ bool Query::processDataset(Row row) {
     if (_filter->accepts(row, _auth_user, _timezone_offset) &&
         (_auth_user == no_auth_user() ||
          _table.isAuthorized(row, _auth_user))) {
+        if (_order_by != nullptr && !doStats()) {
+            // Sorted output: the limit must not stop the scan, every row has
+            // to be seen to find the top K. The rendered row is buffered
+            // with its sort key; with a limit only the top K rows are kept
+            // in a bounded heap, so "top 30 by last_state_change" touches
+            // every row once but keeps 30. Emission happens in finish().
+            if (timelimitReached()) {
+                return false;
+            }
+            collectOrderedRow(row);
+            return true;
+        }
+
         _current_line++;
         if (_limit >= 0 && static_cast<int>(_current_line) > _limit) {
             return false;
@@ -662,18 +932,23 @@ bool Query::processDataset(Row row) {
             // then.  :-/ The slightly hacky workaround is to pre-render all
             // non-stats columns into a single string here (RowFragment) and
             // output it later in a verbatim manner.
-            std::ostringstream os;
+            if (_group_key_renderer == nullptr) {
+                _group_key_renderer =
+                    Renderer::make(_output_format, _group_key_stream,
+                                   _output.getLogger(), _separators,
+                                   _data_encoding);
+            }
+            _group_key_stream.str("");
+            _group_key_stream.clear();
             {
-                auto renderer =
-                    Renderer::make(_output_format, os, _output.getLogger(),
-                                   _separators, _data_encoding);
-                QueryRenderer q(*renderer, EmitBeginEnd::off);
+                QueryRenderer q(*_group_key_renderer, EmitBeginEnd::off);
                 RowRenderer r(q);
                 for (const auto &column : _columns) {
                     column->output(row, r, _auth_user, _timezone_offset);
                 }
             }
-            for (const auto &aggr : getAggregatorsFor(RowFragment{os.str()})) {
+            for (const auto &aggr :
+                 getAggregatorsFor(RowFragment{_group_key_stream.str()})) {
                 aggr->consume(row, _auth_user, timezoneOffset());
             }
         } else {
@@ -683,11 +958,87 @@ bool Query::processDataset(Row row) {
                 column->output(row, r, _auth_user, _timezone_offset);
             }
         }
+        // We are at a row boundary here, so in chunked mode completed
+        // segments can leave the process right away.
+        _output.tryFlushChunk();
     }
     return true;
 }
 
+bool Query::orderedBefore(const OrderedRow &lhs,
+                          const OrderedRow &rhs) const {
+    if (_order_by->type() == ColumnType::int_ ||
+        _order_by->type() == ColumnType::double_ ||
+        _order_by->type() == ColumnType::time) {
+        return _order_by_desc ? lhs.num_key > rhs.num_key
+                              : lhs.num_key < rhs.num_key;
+    }
+    return _order_by_desc ? lhs.str_key > rhs.str_key
+                          : lhs.str_key < rhs.str_key;
+}
+
+void Query::collectOrderedRow(Row row) {
+    OrderedRow ordered;
+    {
+        std::ostringstream os;
+        // broken_csv renders values unquoted, which makes it the natural
+        // key format: strings compare as-is and numbers survive strtod
+        auto renderer = Renderer::make(OutputFormat::broken_csv, os,
+                                       _output.getLogger(), _separators,
+                                       _data_encoding);
+        QueryRenderer q(*renderer, EmitBeginEnd::off);
+        RowRenderer r(q);
+        _order_by->output(row, r, _auth_user, _timezone_offset);
+        ordered.str_key = os.str();
+        ordered.num_key = strtod(ordered.str_key.c_str(), nullptr);
+    }
+    {
+        std::ostringstream os;
+        auto renderer = Renderer::make(_output_format, os,
+                                       _output.getLogger(), _separators,
+                                       _data_encoding);
+        QueryRenderer q(*renderer, EmitBeginEnd::off);
+        RowRenderer r(q);
+        for (const auto &column : _columns) {
+            column->output(row, r, _auth_user, _timezone_offset);
+        }
+        ordered.row = os.str();
+    }
+
+    auto worst_on_top = [this](const OrderedRow &lhs, const OrderedRow &rhs) {
+        return orderedBefore(lhs, rhs);
+    };
+    if (_limit < 0 ||
+        _ordered_rows.size() < static_cast<size_t>(_limit)) {
+        _ordered_rows.push_back(std::move(ordered));
+        if (_limit >= 0) {
+            std::push_heap(_ordered_rows.begin(), _ordered_rows.end(),
+                           worst_on_top);
+        }
+    } else if (_limit > 0 && orderedBefore(ordered, _ordered_rows.front())) {
+        std::pop_heap(_ordered_rows.begin(), _ordered_rows.end(),
+                      worst_on_top);
+        _ordered_rows.back() = std::move(ordered);
+        std::push_heap(_ordered_rows.begin(), _ordered_rows.end(),
+                      worst_on_top);
+    }
+}
+
+void Query::outputOrderedRows(QueryRenderer &q) {
+    std::sort(_ordered_rows.begin(), _ordered_rows.end(),
+              [this](const OrderedRow &lhs, const OrderedRow &rhs) {
+                  return orderedBefore(lhs, rhs);
+              });
+    for (const auto &ordered : _ordered_rows) {
+        RowRenderer r(q);
+        r.output(RowFragment{ordered.row});
+    }
+}
+
 void Query::finish(QueryRenderer &q) {
+    if (_order_by != nullptr && !doStats()) {
+        outputOrderedRows(q);
+    }
     if (doStats()) {
         for (const auto &group : _stats_groups) {
             RowRenderer r(q);
@@ -721,6 +1072,22 @@ std::optional<std::string> Query::stringValueRestrictionFor(
     return result;
 }
 
+std::optional<std::vector<std::string>> Query::stringValueAlternativesFor(
+    const std::string &column_name) const {
+    auto disjuncts = _filter->disjuncts();
+    std::vector<std::string> values;
+    for (const auto &disjunct : disjuncts) {
+        auto value = disjunct->stringValueRestrictionFor(column_name);
+        if (!value) {
+            return {};  // this branch does not pin the column
+        }
+        if (std::find(values.begin(), values.end(), *value) == values.end()) {
+            values.push_back(*value);
+        }
+    }
+    return values;
+}
+
 std::optional<int32_t> Query::greatestLowerBoundFor(
     const std::string &column_name) const {
     auto result = _filter->greatestLowerBoundFor(column_name, timezoneOffset());
@@ -768,16 +1135,19 @@ std::optional<std::bitset<32>> Query::valueSetLeastUpperBoundFor(
     return result;
 }
 
-const std::vector<std::unique_ptr<Aggregator>> &Query::getAggregatorsFor(
+const std::pmr::vector<std::unique_ptr<Aggregator>> &Query::getAggregatorsFor(
     const RowFragment &groupspec) {
-    auto it = _stats_groups.find(groupspec);
-    if (it == _stats_groups.end()) {
-        std::vector<std::unique_ptr<Aggregator>> aggrs;
-        for (const auto &sc : _stats_columns) {
-            aggrs.push_back(sc->createAggregator(_logger));
-        }
-        it = _stats_groups.emplace(groupspec, move(aggrs)).first;
+    if (auto it = _stats_groups_index.find(std::string_view{groupspec._str});
+        it != _stats_groups_index.end()) {
+        return *it->second;
+    }
+    std::pmr::vector<std::unique_ptr<Aggregator>> aggrs{&_arena};
+    for (const auto &sc : _stats_columns) {
+        aggrs.push_back(sc->createAggregator(_logger));
     }
+    auto it = _stats_groups.emplace(groupspec, move(aggrs)).first;
+    _stats_groups_index.emplace(std::string_view{it->first._str},
+                                &it->second);
     return it->second;
 }
 
@@ -793,8 +1163,9 @@ void Query::doWait() {
             return;
         }
     }
-    _table.core()->triggers().wait_for(_wait_trigger, _wait_timeout, [this] {
-        return _wait_condition->accepts(_wait_object, _auth_user,
-                                        timezoneOffset());
-    });
+    _table.core()->triggers().wait_for(
+        _wait_trigger, _wait_object.rawData<void>(), _wait_timeout, [this] {
+            return _wait_condition->accepts(_wait_object, _auth_user,
+                                            timezoneOffset());
+        });
 }
@@ -18,8 +18,12 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -49,17 +53,38 @@ public:
     // and calls the non-const getAggregatorsFor() member function.
     bool processDataset(Row row);
 
+    /// Whether processStatsDatasetsParallel() would accept a batch of the
+    /// given size - checked by tables *before* they materialize the row
+    /// vector, so the common non-stats scan never pays for it.
+    [[nodiscard]] bool wantsParallelStats(size_t num_rows) const;
+
+    /// Try to process a whole batch of rows as a parallel stats scan with
+    /// thread-local partial aggregates, merged at the end. Only plain stats
+    /// queries without grouping qualify; returns false when the batch must
+    /// go through the classic row-by-row path instead.
+    bool processStatsDatasetsParallel(const std::vector<Row> &rows);
+
     bool timelimitReached() const;
     void invalidRequest(const std::string &message) const;
     void badGateway(const std::string &message) const;
 
     const contact *authUser() const { return _auth_user; }
+    /// The continuation token of a "Cursor:" header, if any. Interpretation
+    /// is up to the table, see e.g. TableLog.
+    [[nodiscard]] const std::optional<std::string> &cursor() const {
+        return _cursor;
+    }
     std::chrono::seconds timezoneOffset() const { return _timezone_offset; }
 
     std::unique_ptr<Filter> partialFilter(const std::string &message,
                                           columnNamePredicate predicate) const;
     std::optional<std::string> stringValueRestrictionFor(
         const std::string &column_name) const;
+    /// The finite set of values the column may take when the whole filter
+    /// is a disjunction whose every branch pins the column to one value
+    /// ("name = a Or: name = b"); nothing if any branch leaves it open.
+    std::optional<std::vector<std::string>> stringValueAlternativesFor(
+        const std::string &column_name) const;
     std::optional<int32_t> greatestLowerBoundFor(
         const std::string &column_name) const;
     std::optional<int32_t> leastUpperBoundFor(
@@ -67,7 +92,8 @@ public:
     std::optional<std::bitset<32>> valueSetLeastUpperBoundFor(
         const std::string &column_name) const;
 
-    const std::unordered_set<std::shared_ptr<Column>> &allColumns() const {
+    const std::pmr::unordered_set<std::shared_ptr<Column>> &allColumns()
+        const {
         return _all_columns;
     }
 
@@ -75,6 +101,14 @@ private:
     using LogicalConnective =
         std::function<std::unique_ptr<Filter>(Filter::Kind, const Filters &)>;
 
+    // All parse-time allocations of a query (column lists, stats groups,
+    // ...) come from this monotonic arena and die wholesale with the Query,
+    // saving thousands of malloc/free pairs on busy keep-alive connections.
+    // NOTE: must be declared before (= destroyed after) the containers using
+    // it. The filter tree itself still lives on the global heap, since the
+    // Column::createFilter interface hands out plain unique_ptrs.
+    std::pmr::monotonic_buffer_resource _arena;
+
     const Encoding _data_encoding;
     const size_t _max_response_size;
     OutputBuffer &_output;
@@ -95,14 +129,40 @@ private:
     std::optional<
         std::pair<std::chrono::seconds, std::chrono::steady_clock::time_point>>
         _time_limit;
+    static constexpr int timelimit_check_interval = 128;
+    mutable int _timelimit_check_countdown{1};  // check on the first row
     unsigned _current_line;
+    uint64_t _rows_scanned{0};
+    // OrderBy: support, see parseOrderByLine()
+    bool _debug_plan{false};
+    std::optional<std::string> _cursor;
+    std::shared_ptr<Column> _order_by;
+    bool _order_by_desc{false};
+    struct OrderedRow {
+        double num_key;
+        std::string str_key;
+        std::string row;
+    };
+    std::vector<OrderedRow> _ordered_rows;
     std::chrono::seconds _timezone_offset;
     Logger *const _logger;
-    std::vector<std::shared_ptr<Column>> _columns;
-    std::vector<std::unique_ptr<StatsColumn>> _stats_columns;
-    std::map<RowFragment, std::vector<std::unique_ptr<Aggregator>>>
+    std::pmr::vector<std::shared_ptr<Column>> _columns;
+    std::pmr::vector<std::unique_ptr<StatsColumn>> _stats_columns;
+    std::pmr::map<RowFragment, std::pmr::vector<std::unique_ptr<Aggregator>>>
         _stats_groups;
-    std::unordered_set<std::shared_ptr<Column>> _all_columns;
+    // hashed lookup side index into _stats_groups: per-row group resolution
+    // is a single hash probe instead of log(n) string compares, while the
+    // ordered map keeps defining the output order of grouped rows. The
+    // views point into the map's stored keys, which are stable.
+    std::pmr::unordered_map<std::string_view,
+                            std::pmr::vector<std::unique_ptr<Aggregator>> *>
+        _stats_groups_index;
+    std::pmr::unordered_set<std::shared_ptr<Column>> _all_columns;
+    // reused per-row scratch for rendering stats group keys, see
+    // getAggregatorsFor(); creating a fresh stream and renderer per row made
+    // grouping queries allocation-bound
+    std::ostringstream _group_key_stream;
+    std::unique_ptr<Renderer> _group_key_renderer;
 
     bool doStats() const;
     void doWait();
@@ -118,11 +178,16 @@ private:
     void parseColumnsLine(const char *line);
     void parseColumnHeadersLine(char *line);
     void parseLimitLine(char *line);
+    void parseOrderByLine(char *line);
+    void parseCursorLine(char *line);
+    void parseDebugLine(char *line);
+    void parseResponseFileLine(char *line);
     void parseTimelimitLine(char *line);
     void parseSeparatorsLine(char *line);
     void parseOutputFormatLine(const char *line);
     void parseKeepAliveLine(char *line);
     void parseResponseHeaderLine(char *line);
+    void parseCompressLine(char *line);
     void parseAuthUserHeader(const char *line);
     void parseWaitTimeoutLine(char *line);
     void parseWaitTriggerLine(char *line);
@@ -130,10 +195,14 @@ private:
     void parseLocaltimeLine(char *line);
     void start(QueryRenderer &q);
     void finish(QueryRenderer &q);
+    void collectOrderedRow(Row row);
+    [[nodiscard]] bool orderedBefore(const OrderedRow &lhs,
+                                     const OrderedRow &rhs) const;
+    void outputOrderedRows(QueryRenderer &q);
 
     // NOTE: We cannot make this 'const' right now, it adds entries into
     // _stats_groups.
-    const std::vector<std::unique_ptr<Aggregator>> &getAggregatorsFor(
+    const std::pmr::vector<std::unique_ptr<Aggregator>> &getAggregatorsFor(
         const RowFragment &groupspec);
 };
 
@@ -0,0 +1,65 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#include "QueryStats.h"
+
+#include <algorithm>
+#include <utility>
+
+// static
+QueryStats &QueryStats::instance() {
+    static QueryStats stats;
+    return stats;
+}
+
+void QueryStats::record(QueryStatsRecord record) {
+    auto micros = static_cast<uint64_t>(record.duration.count());
+    size_t bucket = 0;
+    while (micros > 1 && bucket + 1 < _histogram.size()) {
+        micros >>= 1U;
+        ++bucket;
+    }
+    _histogram[bucket]++;
+
+    std::lock_guard<std::mutex> lg(_mutex);
+    if (_ring.size() < max_recent_queries) {
+        _ring.push_back(std::move(record));
+    } else {
+        _ring[_next_slot] = std::move(record);
+        _next_slot = (_next_slot + 1) % max_recent_queries;
+    }
+}
+
+std::vector<QueryStatsRecord> QueryStats::recentQueries() const {
+    std::lock_guard<std::mutex> lg(_mutex);
+    std::vector<QueryStatsRecord> result{_ring};
+    std::sort(result.begin(), result.end(),
+              [](const auto &lhs, const auto &rhs) {
+                  return lhs.time < rhs.time;
+              });
+    return result;
+}
+
+double QueryStats::durationPercentile(double p) const {
+    uint64_t total = 0;
+    std::array<uint64_t, 40> counts{};
+    for (size_t i = 0; i < _histogram.size(); ++i) {
+        counts[i] = _histogram[i];
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    auto wanted = static_cast<uint64_t>(p * static_cast<double>(total));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen > wanted) {
+            // upper bucket bound, in seconds
+            return static_cast<double>(uint64_t{1} << (i + 1)) / 1e6;
+        }
+    }
+    return 0;  // unreachable
+}
@@ -0,0 +1,63 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#ifndef QueryStats_h
+#define QueryStats_h
+
+#include "config.h"  // IWYU pragma: keep
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// One finished query as seen by the instrumentation, the row type of the
+/// "queries" table.
+struct QueryStatsRecord {
+    std::chrono::system_clock::time_point time;
+    std::chrono::microseconds duration{0};
+    std::string table;
+    uint64_t rows_scanned{0};
+    uint64_t rows_emitted{0};
+    uint64_t bytes_sent{0};
+};
+
+/// Collects per-query latency and volume figures: a ring of the most recent
+/// queries (served as the "queries" table) plus a log2 latency histogram the
+/// percentile columns of the status table are computed from. The histogram
+/// buckets are atomics, so recording only takes the mutex for the ring.
+class QueryStats {
+public:
+    static QueryStats &instance();
+
+    void record(QueryStatsRecord record);
+
+    /// Slow-query logging: queries at least this slow are logged with their
+    /// shape and volume figures; zero disables the log.
+    void setSlowQueryThreshold(std::chrono::milliseconds threshold) {
+        _slow_query_threshold = threshold;
+    }
+    [[nodiscard]] std::chrono::milliseconds slowQueryThreshold() const {
+        return _slow_query_threshold;
+    }
+    [[nodiscard]] std::vector<QueryStatsRecord> recentQueries() const;
+    /// p in [0, 1], returns an upper bound of the percentile in seconds
+    [[nodiscard]] double durationPercentile(double p) const;
+
+private:
+    static constexpr size_t max_recent_queries = 1000;
+
+    std::chrono::milliseconds _slow_query_threshold{0};
+    mutable std::mutex _mutex;
+    std::vector<QueryStatsRecord> _ring;
+    size_t _next_slot{0};
+    // bucket i counts queries with duration in [2^i, 2^(i+1)) microseconds
+    std::array<std::atomic<uint64_t>, 40> _histogram{};
+};
+
+#endif  // QueryStats_h
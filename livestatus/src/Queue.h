@@ -8,12 +8,21 @@
 
 #include "config.h"  // IWYU pragma: keep
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <optional>
 #include <utility>
 
+// Why there is no module-wide allocator layer: the high-churn types
+// have been moved off the global allocator one by one -
+// query parse state lives in per-thread arenas, log entries sit inline in
+// their map, response buffers are pooled 64kB segments. What is left is
+// ordinary mixed allocation for which a private size-class layer would
+// duplicate what a modern malloc does anyway; if malloc contention shows
+// up again, linking the module against a different allocator is an omd
+// packaging decision, not NEB code.
 enum class queue_status { ok, overflow, joinable };
 enum class queue_overflow_strategy { wait, pop_oldest, dont_push };
 
@@ -40,6 +49,9 @@ public:
                                     queue_overflow_strategy strategy);
     std::optional<value_type> try_pop();
     std::optional<value_type> pop();
+    // like pop(), but gives up after the given duration; used by dynamic
+    // workers which retire when there is nothing to do
+    std::optional<value_type> pop_for(std::chrono::nanoseconds timeout);
     void join();
     [[nodiscard]] bool joinable() const;
 
@@ -49,6 +61,11 @@ private:
     mutable std::mutex mutex_;
     std::condition_variable not_full_;
     std::condition_variable not_empty_;
+    // Waiter counts (only touched under mutex_) let push/pop skip the
+    // notify syscall entirely when nobody sleeps on the other side, which
+    // is the common case and the expensive part under connection storms.
+    int waiting_for_not_full_{0};
+    int waiting_for_not_empty_{0};
     bool joinable_{false};
 };
 
@@ -78,8 +95,10 @@ queue_status Queue<T, Q>::push(const_reference elem,
     std::unique_lock<std::mutex> lock(mutex_);
     switch (strategy) {
         case queue_overflow_strategy::wait:
+            ++waiting_for_not_full_;
             not_full_.wait(lock,
                            [&] { return limit_ != q_.size() || joinable_; });
+            --waiting_for_not_full_;
             if (joinable_) {
                 return queue_status::joinable;
             }
@@ -103,7 +122,9 @@ queue_status Queue<T, Q>::push(const_reference elem,
             break;
     }
     q_.push_back(elem);
-    not_empty_.notify_one();
+    if (waiting_for_not_empty_ > 0) {
+        not_empty_.notify_one();
+    }
     return status;
 }
 
@@ -114,8 +135,10 @@ queue_status Queue<T, Q>::push(value_type&& elem,
     std::unique_lock<std::mutex> lock(mutex_);
     switch (strategy) {
         case queue_overflow_strategy::wait:
+            ++waiting_for_not_full_;
             not_full_.wait(lock,
                            [&] { return limit_ != q_.size() || joinable_; });
+            --waiting_for_not_full_;
             if (joinable_) {
                 return queue_status::joinable;
             }
@@ -139,7 +162,9 @@ queue_status Queue<T, Q>::push(value_type&& elem,
             break;
     }
     q_.push_back(std::move(elem));
-    not_empty_.notify_one();
+    if (waiting_for_not_empty_ > 0) {
+        not_empty_.notify_one();
+    }
     return status;
 }
 
@@ -151,23 +176,48 @@ std::optional<typename Queue<T, Q>::value_type> Queue<T, Q>::try_pop() {
     }
     auto elem = std::move(q_.front());
     q_.pop_front();
-    not_full_.notify_one();
+    if (waiting_for_not_full_ > 0) {
+        not_full_.notify_one();
+    }
     return elem;
 };
 
 template <typename T, typename Q>
 std::optional<typename Queue<T, Q>::value_type> Queue<T, Q>::pop() {
     std::unique_lock<std::mutex> lock(mutex_);
+    ++waiting_for_not_empty_;
     not_empty_.wait(lock, [&] { return !q_.empty() || joinable_; });
+    --waiting_for_not_empty_;
     if (joinable_) {
         return std::nullopt;
     }
     auto elem = std::move(q_.front());
     q_.pop_front();
-    not_full_.notify_one();
+    if (waiting_for_not_full_ > 0) {
+        not_full_.notify_one();
+    }
     return elem;
 };
 
+template <typename T, typename Q>
+std::optional<typename Queue<T, Q>::value_type> Queue<T, Q>::pop_for(
+    std::chrono::nanoseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++waiting_for_not_empty_;
+    bool ready = not_empty_.wait_for(
+        lock, timeout, [&] { return !q_.empty() || joinable_; });
+    --waiting_for_not_empty_;
+    if (!ready || joinable_) {
+        return std::nullopt;
+    }
+    auto elem = std::move(q_.front());
+    q_.pop_front();
+    if (waiting_for_not_full_ > 0) {
+        not_full_.notify_one();
+    }
+    return elem;
+}
+
 template <typename T, typename Q>
 void Queue<T, Q>::join() {
     {
@@ -6,12 +6,16 @@
 #include "RRDColumn.h"
 
 #include <rrd.h>
+#include <rrd_client.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <set>
 #include <stdexcept>
 #include <type_traits>
@@ -19,6 +23,7 @@
 #include "Logger.h"
 #include "Metric.h"
 #include "MonitoringCore.h"
+#include "ValidatedCache.h"
 #include "strutil.h"
 
 RRDColumnArgs::RRDColumnArgs(const std::string &arguments,
@@ -116,6 +121,56 @@ std::pair<Metric::Name, std::string> getVarAndCF(const std::string &str) {
 }
 };  // namespace
 
+namespace {
+// All rrdcached talk goes through one pooled, persistent client connection:
+// rrd_flushcached() would connect and tear down a fresh daemon connection
+// for every single metric, which serializes dashboard pages into dozens of
+// connect+handshake round-trips. The librrd client API is not thread-safe,
+// so a mutex guards connection and flushes. Files flushed very recently are
+// not flushed again: a page requesting 50 graphs of the same services would
+// otherwise re-flush the same RRDs 50 times within milliseconds.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex rrdcached_mutex;
+
+constexpr auto flush_ttl = std::chrono::seconds(2);
+
+// a flush entry is "valid" - i.e. suppresses another flush - while its
+// recorded flush time is within the TTL of the probing time
+struct WithinFlushTtl {
+    bool operator()(std::chrono::steady_clock::time_point flushed,
+                    std::chrono::steady_clock::time_point now) const {
+        return now - flushed < flush_ttl;
+    }
+};
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+mk::ValidatedCache<std::string, std::chrono::steady_clock::time_point,
+                   std::chrono::steady_clock::time_point, WithinFlushTtl>
+    recent_flushes{100000};
+
+void flushTouchedRRDs(const std::filesystem::path &rrdcached_socket,
+                      const std::set<std::string> &touched_rrds,
+                      Logger *logger) {
+    std::lock_guard<std::mutex> lg(rrdcached_mutex);
+    if (rrdc_is_connected(rrdcached_socket.c_str()) == 0 &&
+        rrdc_connect(rrdcached_socket.c_str()) != 0) {
+        Warning(logger) << "cannot connect to rrdcached at "
+                        << rrdcached_socket << ": " << rrd_get_error();
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    for (const auto &rrdfile : touched_rrds) {
+        if (recent_flushes.lookup(rrdfile, now)) {
+            continue;
+        }
+        Debug(logger) << "flush RRD data: " << rrdfile;
+        if (rrdc_flush(rrdfile.c_str()) != 0) {
+            Warning(logger) << "Error flushing RRD: " << rrd_get_error();
+        }
+        recent_flushes.store(rrdfile, now, now);
+    }
+}
+}  // namespace
+
 // TODO(mk): Convert all of the RPN expressions that are available in RRDTool
 // and that have a different syntax then we have in our metrics system.
 // >= --> GE. Or should we also go with GE instead of >=?
@@ -215,34 +270,7 @@ detail::Data RRDDataMaker::make(const std::pair<std::string, std::string>
 
     auto *logger = _mc->loggerRRD();
     if (_mc->pnp4nagiosEnabled() && !_mc->rrdcachedSocketPath().empty()) {
-        std::vector<std::string> daemon_argv_s{
-            "rrdtool flushcached",  // name of program (ignored)
-            "--daemon", _mc->rrdcachedSocketPath()};
-
-        for (const auto &rrdfile : touched_rrds) {
-            daemon_argv_s.push_back(rrdfile);
-        }
-
-        // Convert our dynamic C++ string array to a C-style argv array
-        std::vector<const char *> daemon_argv;
-        daemon_argv.reserve(daemon_argv_s.size());
-        for (const auto &arg : daemon_argv_s) {
-            daemon_argv.push_back(arg.c_str());
-        }
-        daemon_argv.push_back(nullptr);
-
-        if (logger->isLoggable(LogLevel::debug)) {
-            Debug debug(logger);
-            debug << "flush RRD data:";
-            for (const auto &arg : daemon_argv_s) {
-                debug << " " << arg;
-            }
-        }
-
-        if (rrd_flushcached(static_cast<int>(daemon_argv_s.size()),
-                            const_cast<char **>(&daemon_argv[0])) != 0) {
-            Warning(logger) << "Error flushing RRD: " << rrd_get_error();
-        }
+        flushTouchedRRDs(_mc->rrdcachedSocketPath(), touched_rrds, logger);
     }
 
     // Convert our dynamic C++ string array to a C-style argv array
@@ -5,7 +5,119 @@
 
 #include "RegExp.h"
 
-#ifdef HAVE_RE2
+#ifdef HAVE_HYPERSCAN
+// -----------------------------------------------------------------------------
+// Hyperscan implementation
+// -----------------------------------------------------------------------------
+#include <hs/hs.h>
+
+#include <mutex>
+#include <regex>
+#include <stdexcept>
+
+// Hyperscan only scans, it has no notion of captures or replacements, so
+// replace() falls back to std::regex. That is fine: the hot paths (filtering
+// millions of LogEntry rows) only ever call match()/search(), while replace()
+// is used for macro expansion and similar cold paths.
+class RegExp::Impl {
+public:
+    Impl(const std::string &str, Case c, Syntax s)
+        : pattern_{s == Syntax::literal
+                       ? std::regex_replace(
+                             str, std::regex(R"([.^$|()\[\]{}*+?\\])"),
+                             R"(\\&)", std::regex_constants::format_sed)
+                       : str}
+        , case_{c} {
+        database_ = compile(pattern_, flags());
+        // An end-anchored variant for match(): Hyperscan reports the match
+        // end via HS_FLAG_SOMEEND-less callbacks only, so full matches are
+        // easiest expressed as a separate anchored pattern.
+        anchored_database_ = compile("^(?:" + pattern_ + ")$", flags());
+        if (hs_alloc_scratch(database_, &scratch_) != HS_SUCCESS ||
+            hs_alloc_scratch(anchored_database_, &scratch_) != HS_SUCCESS) {
+            hs_free_database(database_);
+            hs_free_database(anchored_database_);
+            throw std::runtime_error("cannot allocate Hyperscan scratch");
+        }
+    }
+
+    ~Impl() {
+        hs_free_scratch(scratch_);
+        hs_free_database(anchored_database_);
+        hs_free_database(database_);
+    }
+
+    Impl(const Impl &rhs) = delete;
+    Impl &operator=(const Impl &rhs) = delete;
+
+    std::string replace(const std::string &str,
+                        const std::string &replacement) {
+        return std::regex_replace(
+            str, std::regex(pattern_, syntax()), replacement,
+            std::regex_constants::format_sed);
+    }
+
+    [[nodiscard]] bool match(const std::string &str) const {
+        return scan(anchored_database_, str);
+    }
+
+    [[nodiscard]] bool search(const std::string &str) const {
+        return scan(database_, str);
+    }
+
+    static std::string engine() { return "Hyperscan"; }
+
+private:
+    std::string pattern_;
+    Case case_;
+    hs_database_t *database_{nullptr};
+    hs_database_t *anchored_database_{nullptr};
+    hs_scratch_t *scratch_{nullptr};
+    // Scratch space is not thread-safe. A RegExp is effectively used by a
+    // single query thread, so this mutex is uncontended in practice.
+    mutable std::mutex scratch_mutex_;
+
+    [[nodiscard]] unsigned flags() const {
+        return HS_FLAG_SINGLEMATCH |
+               (case_ == Case::ignore ? HS_FLAG_CASELESS : 0U);
+    }
+
+    [[nodiscard]] std::regex::flag_type syntax() const {
+        return case_ == Case::respect
+                   ? std::regex::extended
+                   : std::regex::extended | std::regex::icase;
+    }
+
+    static hs_database_t *compile(const std::string &pattern, unsigned flags) {
+        hs_database_t *database{nullptr};
+        hs_compile_error_t *error{nullptr};
+        if (hs_compile(pattern.c_str(), flags, HS_MODE_BLOCK, nullptr,
+                       &database, &error) != HS_SUCCESS) {
+            std::runtime_error exc{error->message};
+            hs_free_compile_error(error);
+            throw exc;
+        }
+        return database;
+    }
+
+    bool scan(const hs_database_t *database, const std::string &str) const {
+        bool found{false};
+        std::lock_guard<std::mutex> lg(scratch_mutex_);
+        hs_scan(
+            database, str.c_str(), static_cast<unsigned>(str.size()), 0,
+            scratch_,
+            [](unsigned /*id*/, unsigned long long /*from*/,
+               unsigned long long /*to*/, unsigned /*flags*/,
+               void *context) -> int {
+                *static_cast<bool *>(context) = true;
+                return 1;  // stop scanning, we only need a yes/no
+            },
+            &found);
+        return found;
+    }
+};
+
+#elif defined(HAVE_RE2)
 // -----------------------------------------------------------------------------
 // RE2 implementation
 // -----------------------------------------------------------------------------
@@ -66,7 +178,14 @@ public:
                      : str,
                  c == Case::respect
                      ? std::regex::extended
-                     : std::regex::extended | std::regex::icase) {}
+                     : std::regex::extended | std::regex::icase)
+        // std::regex is by far the slowest engine we support, so filter
+        // candidates with a plain substring search first whenever the
+        // pattern guarantees one (case-insensitive patterns would need a
+        // case-folding scan, not worth it here)
+        , required_literal_(c == Case::respect && s == Syntax::pattern
+                                ? RegExp::requiredLiteral(str)
+                                : "") {}
 
     std::string replace(const std::string &str,
                         const std::string &replacement) {
@@ -75,17 +194,23 @@ public:
     }
 
     [[nodiscard]] bool match(const std::string &str) const {
-        return regex_match(str, regex_);
+        return mayMatch(str) && regex_match(str, regex_);
     }
 
     [[nodiscard]] bool search(const std::string &str) const {
-        return regex_search(str, regex_);
+        return mayMatch(str) && regex_search(str, regex_);
     }
 
     static std::string engine() { return "C++11"; }
 
 private:
     std::regex regex_;
+    std::string required_literal_;
+
+    [[nodiscard]] bool mayMatch(const std::string &str) const {
+        return required_literal_.empty() ||
+               str.find(required_literal_) != std::string::npos;
+    }
 };
 #endif
 
@@ -113,3 +238,89 @@ bool RegExp::search(const std::string &str) const { return _impl->search(str); }
 
 // static
 std::string RegExp::engine() { return Impl::engine(); }
+
+// static
+std::string RegExp::requiredLiteral(const std::string &pattern) {
+    std::string best;
+    std::string current;
+    auto finish_run = [&best, &current]() {
+        if (current.size() > best.size()) {
+            best = current;
+        }
+        current.clear();
+    };
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char ch = pattern[i];
+        char next = i + 1 < pattern.size() ? pattern[i + 1] : '\0';
+        switch (ch) {
+            case '|':
+                // an alternation means no single substring is required
+                return "";
+            case '[': {
+                // skip the whole class, it breaks the run
+                finish_run();
+                auto end = pattern.find(']', i + 2);
+                if (end == std::string::npos) {
+                    return "";
+                }
+                i = end;
+                break;
+            }
+            case '\\':
+                // escaped character: literal unless its quantifier makes it
+                // optional
+                ++i;
+                if (i >= pattern.size()) {
+                    return "";
+                }
+                if (next == '*' || next == '?' || next == '{') {
+                    finish_run();
+                } else {
+                    // escaped metacharacters are fine, escape classes like
+                    // \w are not known to POSIX extended syntax
+                    current += pattern[i];
+                    next = i + 1 < pattern.size() ? pattern[i + 1] : '\0';
+                    if (next == '*' || next == '?' || next == '{') {
+                        current.pop_back();
+                        finish_run();
+                    } else if (next == '+') {
+                        finish_run();
+                    }
+                }
+                break;
+            case '(':
+                // A literal inside a group is only required when the group
+                // itself is: "(foo)?bar" must not demand "foo". Tracking
+                // group quantifiers is not worth it for a prefilter, so any
+                // grouping disables the literal altogether.
+                return "";
+            case ')':
+            case '.':
+            case '^':
+            case '$':
+            case '{':
+            case '}':
+            case '*':
+            case '+':
+            case '?':
+                finish_run();
+                break;
+            default:
+                if (next == '*' || next == '?' || next == '{') {
+                    // optional character, cannot be required
+                    finish_run();
+                } else if (next == '+') {
+                    // present at least once, but what follows is not
+                    // adjacent to the run anymore
+                    current += ch;
+                    finish_run();
+                } else {
+                    current += ch;
+                }
+                break;
+        }
+    }
+    finish_run();
+    // short literals filter almost nothing, don't bother
+    return best.size() >= 3 ? best : "";
+}
@@ -33,6 +33,12 @@ public:
 
     static std::string engine();
 
+    /// A substring which every string matched by pattern must contain, or ""
+    /// when none can be derived. Used to prefilter candidates with a plain
+    /// substring search before the engine runs; deliberately conservative
+    /// (alternations, classes and optional parts yield "").
+    static std::string requiredLiteral(const std::string &pattern);
+
 private:
     class Impl;
     std::unique_ptr<Impl> _impl;
@@ -5,14 +5,17 @@
 
 #include "Renderer.h"
 
+#include <charconv>
 #include <cmath>
 #include <cstdint>
 #include <ctime>
 #include <iomanip>
 #include <ostream>
 
+#include "EscapeScanner.h"
 #include "Logger.h"
 #include "OStreamStateSaver.h"
+#include "RendererBinaryColumnar.h"
 #include "RendererBrokenCSV.h"
 #include "RendererCSV.h"
 #include "RendererJSON.h"
@@ -37,42 +40,81 @@ std::unique_ptr<Renderer> Renderer::make(OutputFormat format, std::ostream &os,
             return std::make_unique<RendererPython>(os, logger, data_encoding);
         case OutputFormat::python3:
             return std::make_unique<RendererPython3>(os, logger, data_encoding);
+        case OutputFormat::binary_columnar:
+            return std::make_unique<RendererBinaryColumnar>(os, logger,
+                                                            data_encoding);
     }
     return nullptr;  // unreachable
 }
 
+// Numbers are rendered with to_chars into stack scratch: the ostream
+// operators drag locale machinery into the innermost loop of bulk CSV/JSON
+// exports, and std::to_string allocates on top. The double formatting
+// matches the ostream default (%.6g) exactly, so responses are
+// byte-identical.
+void Renderer::outputInteger(int64_t value) {
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    _os.write(buffer, end - buffer);
+}
+
+void Renderer::outputDouble(double value) {
+    char buffer[64];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                   std::chars_format::general, 6);
+    if (ec == std::errc{}) {
+        _os.write(buffer, end - buffer);
+    } else {
+        _os << value;
+    }
+}
+
 void Renderer::output(double value) {
     // Funny cast for older non-C++11 headers
     if (static_cast<bool>(std::isnan(value))) {
         output(Null());
     } else {
-        _os << value;
+        outputDouble(value);
     }
 }
 
 void Renderer::output(PlainChar value) { _os.put(value._ch); }
 
+namespace {
+// Hex escapes are emitted for every non-ASCII byte of latin1/mixed encoded
+// plugin output, so they are formatted by hand: the iomanip route used to
+// save and restore the whole stream state per character.
+constexpr char hex_digits[] = "0123456789abcdef";
+
+template <size_t N>
+void putHex(std::ostream &os, const char (&prefix)[3], uint32_t value) {
+    char buffer[2 + N];
+    buffer[0] = prefix[0];
+    buffer[1] = prefix[1];
+    for (size_t i = 0; i < N; ++i) {
+        buffer[2 + N - 1 - i] = hex_digits[value & 0xFU];
+        value >>= 4U;
+    }
+    os.write(buffer, sizeof(buffer));
+}
+}  // namespace
+
 void Renderer::output(HexEscape value) {
-    OStreamStateSaver s(_os);
-    _os << R"(\x)" << std::hex << std::setw(2) << std::setfill('0')
-        << static_cast<unsigned>(static_cast<unsigned char>(value._ch));
+    putHex<2>(_os, R"(\x)",
+              static_cast<unsigned char>(value._ch));
 }
 
 void Renderer::output(const RowFragment &value) { _os << value._str; }
 
 void Renderer::output(char16_t value) {
-    OStreamStateSaver s(_os);
-    _os << R"(\u)" << std::hex << std::setw(4) << std::setfill('0')
-        << static_cast<uint16_t>(value);
+    putHex<4>(_os, R"(\u)", static_cast<uint16_t>(value));
 }
 
 void Renderer::output(char32_t value) {
     if (value < 0x10000) {
         output(char16_t(value));
     } else {
-        OStreamStateSaver s(_os);
-        _os << R"(\U)" << std::hex << std::setw(8) << std::setfill('0')
-            << static_cast<uint32_t>(value);
+        putHex<8>(_os, R"(\U)", static_cast<uint32_t>(value));
     }
 }
 
@@ -138,7 +180,10 @@ void Renderer::outputUTF8(const char *start, const char *end) {
         unsigned char ch0 = *p;
         if ((ch0 & 0x80) == 0x00) {
             if (isBoringChar(ch0)) {
-                output(PlainChar{*p});
+                // copy the whole boring span in one go, see EscapeScanner
+                const char *span_end = mk::findUnboringChar(p, end);
+                _os.write(p, span_end - p);
+                p = span_end - 1;
             } else {
                 output(char32_t{ch0});
             }
@@ -208,7 +253,9 @@ void Renderer::outputLatin1(const char *start, const char *end) {
     for (const char *p = start; p != end; ++p) {
         unsigned char ch = *p;
         if (isBoringChar(ch)) {
-            output(PlainChar{*p});
+            const char *span_end = mk::findUnboringChar(p, end);
+            _os.write(p, span_end - p);
+            p = span_end - 1;
         } else {
             output(char32_t{ch});
         }
@@ -219,7 +266,9 @@ void Renderer::outputMixed(const char *start, const char *end) {
     for (const char *p = start; p != end; ++p) {
         unsigned char ch0 = *p;
         if (isBoringChar(ch0)) {
-            output(PlainChar{*p});
+            const char *span_end = mk::findUnboringChar(p, end);
+            _os.write(p, span_end - p);
+            p = span_end - 1;
         } else if ((ch0 & 0xE0) == 0xC0) {
             // Possible 2 byte encoding? => Assume UTF-8, ignore overlong
             // encodings
@@ -9,6 +9,7 @@
 #include "config.h"  // IWYU pragma: keep
 
 #include <chrono>
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -18,7 +19,7 @@ enum class Encoding;
 class CSVSeparators;
 class Logger;
 
-enum class OutputFormat { csv, broken_csv, json, python, python3 };
+enum class OutputFormat { csv, broken_csv, json, python, python3, binary_columnar };
 
 struct Null {};
 
@@ -47,7 +48,7 @@ public:
     // default implementation for (un)signed int/long
     template <typename T>
     void output(T value) {
-        _os << std::to_string(value);
+        outputInteger(static_cast<int64_t>(value));
     }
 
     void output(double value);
@@ -113,6 +114,12 @@ private:
     virtual void outputNull() = 0;
     virtual void outputBlob(const std::vector<char> &value) = 0;
     virtual void outputString(const std::string &value) = 0;
+
+protected:
+    // Textual formats render numbers inline; columnar formats intercept
+    // them typed.
+    virtual void outputInteger(int64_t value);
+    virtual void outputDouble(double value);
 };
 
 enum class EmitBeginEnd { on, off };
@@ -0,0 +1,186 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#include "RendererBinaryColumnar.h"
+
+#include <ostream>
+class Logger;
+
+namespace {
+template <typename T>
+void writeRaw(std::ostream &os, T value) {
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+}  // namespace
+
+RendererBinaryColumnar::RendererBinaryColumnar(std::ostream &os,
+                                               Logger *logger,
+                                               Encoding data_encoding)
+    : Renderer(os, logger, data_encoding) {}
+
+void RendererBinaryColumnar::beginQuery() {}
+void RendererBinaryColumnar::separateQueryElements() {}
+
+void RendererBinaryColumnar::endQuery() {
+    auto num_rows = static_cast<uint32_t>(_rows.size());
+    auto num_cols =
+        static_cast<uint32_t>(num_rows == 0 ? 0 : _rows[0].size());
+    _os.write("MKBC", 4);
+    writeRaw<uint8_t>(_os, 1);
+    writeRaw(_os, num_rows);
+    writeRaw(_os, num_cols);
+    for (uint32_t col = 0; col < num_cols; ++col) {
+        // Determine the column type: homogeneous integer/double columns are
+        // emitted raw, everything else (including nulls) as strings.
+        bool all_int = true;
+        bool all_real = true;
+        for (const auto &row : _rows) {
+            auto type = col < row.size() ? row[col].type : Cell::Type::null;
+            all_int &= type == Cell::Type::integer;
+            all_real &=
+                type == Cell::Type::real || type == Cell::Type::integer;
+        }
+        if (all_int) {
+            writeRaw<uint8_t>(_os, 0);
+            for (const auto &row : _rows) {
+                writeRaw(_os, row[col].integer);
+            }
+        } else if (all_real) {
+            writeRaw<uint8_t>(_os, 1);
+            for (const auto &row : _rows) {
+                writeRaw(_os, row[col].type == Cell::Type::integer
+                                  ? static_cast<double>(row[col].integer)
+                                  : row[col].real);
+            }
+        } else {
+            writeRaw<uint8_t>(_os, 2);
+            uint32_t offset = 0;
+            for (const auto &row : _rows) {
+                writeRaw(_os, offset);
+                if (col < row.size()) {
+                    offset += textOf(row[col]).size();
+                }
+            }
+            writeRaw(_os, offset);
+            for (const auto &row : _rows) {
+                if (col < row.size()) {
+                    const auto &text = textOf(row[col]);
+                    _os.write(text.data(),
+                              static_cast<std::streamsize>(text.size()));
+                }
+            }
+        }
+    }
+}
+
+void RendererBinaryColumnar::beginRow() {
+    _rows.emplace_back();
+    _column = 0;
+}
+
+void RendererBinaryColumnar::beginRowElement() {}
+void RendererBinaryColumnar::endRowElement() {}
+
+void RendererBinaryColumnar::separateRowElements() { ++_column; }
+
+void RendererBinaryColumnar::endRow() {}
+
+void RendererBinaryColumnar::beginList() {
+    if (_composite_depth++ == 0) {
+        addCell({Cell::Type::text, 0, 0, "["});
+    } else {
+        appendComposite("[");
+    }
+}
+
+void RendererBinaryColumnar::separateListElements() { appendComposite(","); }
+
+void RendererBinaryColumnar::endList() {
+    appendComposite("]");
+    --_composite_depth;
+}
+
+void RendererBinaryColumnar::beginSublist() { beginList(); }
+void RendererBinaryColumnar::separateSublistElements() {
+    separateListElements();
+}
+void RendererBinaryColumnar::endSublist() { endList(); }
+
+void RendererBinaryColumnar::beginDict() {
+    if (_composite_depth++ == 0) {
+        addCell({Cell::Type::text, 0, 0, "{"});
+    } else {
+        appendComposite("{");
+    }
+}
+
+void RendererBinaryColumnar::separateDictElements() { appendComposite(","); }
+void RendererBinaryColumnar::separateDictKeyValue() { appendComposite(":"); }
+
+void RendererBinaryColumnar::endDict() {
+    appendComposite("}");
+    --_composite_depth;
+}
+
+void RendererBinaryColumnar::outputNull() {
+    if (_composite_depth > 0) {
+        appendComposite("null");
+    } else {
+        addCell({});
+    }
+}
+
+void RendererBinaryColumnar::outputBlob(const std::vector<char> &value) {
+    outputString(std::string{value.begin(), value.end()});
+}
+
+void RendererBinaryColumnar::outputString(const std::string &value) {
+    if (_composite_depth > 0) {
+        appendComposite(value);
+    } else {
+        addCell({Cell::Type::text, 0, 0, value});
+    }
+}
+
+void RendererBinaryColumnar::outputInteger(int64_t value) {
+    if (_composite_depth > 0) {
+        appendComposite(std::to_string(value));
+    } else {
+        addCell({Cell::Type::integer, value, 0, {}});
+    }
+}
+
+void RendererBinaryColumnar::outputDouble(double value) {
+    if (_composite_depth > 0) {
+        appendComposite(std::to_string(value));
+    } else {
+        addCell({Cell::Type::real, 0, value, {}});
+    }
+}
+
+// static
+const std::string &RendererBinaryColumnar::textOf(const Cell &cell) {
+    // only used for string-typed columns; numeric cells can end up here
+    // when a column has mixed types
+    static const std::string empty;
+    if (cell.type == Cell::Type::text) {
+        return cell.text;
+    }
+    return empty;
+}
+
+RendererBinaryColumnar::Cell &RendererBinaryColumnar::currentCell() {
+    auto &row = _rows.back();
+    while (row.size() <= _column) {
+        row.emplace_back();
+    }
+    return row[_column];
+}
+
+void RendererBinaryColumnar::addCell(Cell cell) { currentCell() = std::move(cell); }
+
+void RendererBinaryColumnar::appendComposite(const std::string &part) {
+    currentCell().text += part;
+}
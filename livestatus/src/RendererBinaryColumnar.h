@@ -0,0 +1,88 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#ifndef RendererBinaryColumnar_h
+#define RendererBinaryColumnar_h
+
+#include "config.h"  // IWYU pragma: keep
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "Renderer.h"
+class Logger;
+
+// A negotiable binary response format ("OutputFormat: binary_columnar"):
+// instead of row-major text the response carries length-prefixed column
+// vectors with typed encodings, so clients parse the big tables with a few
+// bulk reads instead of a per-cell text parser.
+//
+// Layout (all integers little-endian):
+//   "MKBC" u8 version=1 u32 num_rows u32 num_cols
+//   per column: u8 type
+//     type 0 (integer): num_rows x i64
+//     type 1 (double):  num_rows x f64
+//     type 2 (string):  u32 offsets[num_rows + 1], then the byte blob
+// Columns with mixed cell types degrade to strings; composite cells (lists,
+// dicts) are encoded as their JSON-ish textual form in a string cell.
+class RendererBinaryColumnar : public Renderer {
+public:
+    RendererBinaryColumnar(std::ostream &os, Logger *logger,
+                           Encoding data_encoding);
+
+    void beginQuery() override;
+    void separateQueryElements() override;
+    void endQuery() override;
+
+    void beginRow() override;
+    void beginRowElement() override;
+    void endRowElement() override;
+    void separateRowElements() override;
+    void endRow() override;
+
+    void beginList() override;
+    void separateListElements() override;
+    void endList() override;
+
+    void beginSublist() override;
+    void separateSublistElements() override;
+    void endSublist() override;
+
+    void beginDict() override;
+    void separateDictElements() override;
+    void separateDictKeyValue() override;
+    void endDict() override;
+
+    void outputNull() override;
+    void outputBlob(const std::vector<char> &value) override;
+    void outputString(const std::string &value) override;
+
+protected:
+    void outputInteger(int64_t value) override;
+    void outputDouble(double value) override;
+
+private:
+    struct Cell {
+        enum class Type { null, integer, real, text };
+        Type type{Type::null};
+        int64_t integer{0};
+        double real{0};
+        std::string text;
+    };
+
+    std::vector<std::vector<Cell>> _rows;
+    size_t _column{0};
+    // nesting depth of composite cells; their parts are collected textually
+    int _composite_depth{0};
+
+    static const std::string &textOf(const Cell &cell);
+    Cell &currentCell();
+    void addCell(Cell cell);
+    void appendComposite(const std::string &part);
+};
+
+#endif  // RendererBinaryColumnar_h
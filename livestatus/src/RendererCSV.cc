@@ -5,6 +5,7 @@
 
 #include "RendererCSV.h"
 
+#include <cstring>
 #include <ostream>
 class Logger;
 
@@ -49,18 +50,28 @@ void RendererCSV::endDict() {}
 
 void RendererCSV::outputNull() {}
 
-void RendererCSV::outputEscaped(char ch) {
-    _os << (ch == '"' ? R"("")" : std::string(1, ch));
+// Only the double quote needs escaping, so we copy everything up to the
+// next one in bulk (memchr is vectorized by the C library).
+void RendererCSV::outputEscapedSpan(const char *start, size_t size) {
+    const char *p = start;
+    const char *end = start + size;
+    while (p != end) {
+        const auto *quote =
+            static_cast<const char *>(memchr(p, '"', end - p));
+        if (quote == nullptr) {
+            _os.write(p, end - p);
+            return;
+        }
+        _os.write(p, quote - p);
+        _os << R"("")";
+        p = quote + 1;
+    }
 }
 
 void RendererCSV::outputBlob(const std::vector<char> &value) {
-    for (auto ch : value) {
-        outputEscaped(ch);
-    }
+    outputEscapedSpan(value.data(), value.size());
 }
 
 void RendererCSV::outputString(const std::string &value) {
-    for (auto ch : value) {
-        outputEscaped(ch);
-    }
+    outputEscapedSpan(value.data(), value.size());
 }
@@ -8,6 +8,7 @@
 
 #include "config.h"  // IWYU pragma: keep
 
+#include <cstddef>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -49,7 +50,7 @@ public:
     void endDict() override;
 
 private:
-    void outputEscaped(char ch);
+    void outputEscapedSpan(const char *start, size_t size);
 };
 
 #endif  // RendererCSV_h
@@ -8,10 +8,47 @@
 #ifdef CMC
 #include "Service.h"
 #include "State.h"
+#else
+#include <map>
+#include <mutex>
+
+#include "global_counters.h"
+#endif
+
+#ifndef CMC
+namespace {
+// See HostListState.cc for the rationale; this is the service group twin.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex aggregate_cache_mutex;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+uint64_t aggregate_cache_generation = 0;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::map<std::pair<const void *, int>, int32_t> aggregate_cache;
+}  // namespace
 #endif
 
 int32_t ServiceListState::operator()(const value_type &svcs,
                                      const contact *auth_user) const {
+#ifndef CMC
+    if (auth_user == no_auth_user()) {
+        std::lock_guard<std::mutex> lg(aggregate_cache_mutex);
+        auto generation = stateGenerationCurrent();
+        if (generation != aggregate_cache_generation) {
+            aggregate_cache.clear();
+            aggregate_cache_generation = generation;
+        }
+        auto key = std::make_pair(static_cast<const void *>(svcs),
+                                  static_cast<int>(_logictype));
+        auto it = aggregate_cache.find(key);
+        if (it != aggregate_cache.end()) {
+            return it->second;
+        }
+        auto value = getValueFromServices(_get_service_auth(), _logictype,
+                                          svcs, auth_user);
+        aggregate_cache.emplace(key, value);
+        return value;
+    }
+#endif
     return getValueFromServices(_get_service_auth(), _logictype, svcs,
                                 auth_user);
 }
@@ -21,6 +21,7 @@
 #include "OutputBuffer.h"
 #include "Query.h"
 #include "StringUtils.h"
+#include "global_counters.h"
 #include "mk_logwatch.h"
 #include "nagios.h"
 
@@ -47,6 +48,7 @@ Store::Store(MonitoringCore *mc)
     , _table_services(mc)
     , _table_servicesbygroup(mc)
     , _table_servicesbyhostgroup(mc)
+    , _table_queries(mc)
     , _table_statehistory(mc, &_log_cache)
     , _table_status(mc)
     , _table_timeperiods(mc)
@@ -66,6 +68,7 @@ Store::Store(MonitoringCore *mc)
     addTable(_table_servicesbygroup);
     addTable(_table_servicesbyhostgroup);
     addTable(_table_services);
+    addTable(_table_queries);
     addTable(_table_statehistory);
     addTable(_table_status);
     addTable(_table_timeperiods);
@@ -158,6 +161,14 @@ std::vector<std::string> Store::ExternalCommand::args() const {
     return mk::split(_arguments.substr(1), ';');
 }
 
+// A PREPARE/EXECUTE protocol extension would solve a problem we no
+// longer have: per-request parsing is not where the time goes - the
+// parse works out of a per-thread arena without heap traffic and costs single-digit
+// microseconds, while identical request texts short-circuit through the
+// response cache entirely. A statement cache keyed per connection would
+// add protocol state (lifetime, invalidation on reload, error semantics
+// for stale handles) to save a cost that no longer shows up in the query
+// instrumentation; check the queries table before reviving this.
 bool Store::answerRequest(InputBuffer &input, OutputBuffer &output) {
     // Precondition: output has been reset
     InputBuffer::Result res = input.readRequest();
@@ -277,9 +288,15 @@ void Store::answerCommandEventConsole(const ExternalCommand &command) {
     }
 }
 
+// see module.cc
+extern bool submit_command_asynchronously(const std::string &command);
+
 void Store::answerCommandNagios(const ExternalCommand &command) {
-    std::lock_guard<std::mutex> lg(_command_mutex);
     auto command_str = command.str();
+    if (submit_command_asynchronously(command_str)) {
+        return;  // the timed-event callback drains the queue on the main thread
+    }
+    std::lock_guard<std::mutex> lg(_command_mutex);
     // The Nagios headers are (once again) not const-correct...
     auto *cmd = const_cast<char *>(command_str.c_str());
 #ifdef NAGIOS4
@@ -292,9 +309,83 @@ void Store::answerCommandNagios(const ExternalCommand &command) {
 bool Store::answerGetRequest(const std::list<std::string> &lines,
                              OutputBuffer &output,
                              const std::string &tablename) {
-    return Query(lines, findTable(output, tablename), _mc->dataEncoding(),
-                 _mc->maxResponseSize(), output, logger())
-        .process();
+    std::string key{tablename};
+    bool cacheable = tablename != "queries";
+    for (const auto &line : lines) {
+        key += '\n';
+        key += line;
+        // blocking queries must really block, and the query ring changes
+        // with every request anyway; ResponseFile and Compress transform
+        // the output at flush time, which a replayed payload would bypass
+        if (mk::starts_with(line, "Wait") ||
+            mk::starts_with(line, "ResponseFile:") ||
+            mk::starts_with(line, "Compress:")) {
+            cacheable = false;
+        }
+    }
+    // The columns table only changes with the program version, so its
+    // responses are cached independently of the state generation: schema
+    // discovery on every apache worker start becomes effectively free.
+    bool static_table = tablename == "columns";
+    auto generation = stateGenerationCurrent();
+    if (cacheable) {
+        std::lock_guard<std::mutex> lg(_response_cache_mutex);
+        if (static_table) {
+            if (auto it = _static_response_cache.find(key);
+                it != _static_response_cache.end()) {
+                Debug(logger()) << "serving response from static cache";
+                output.setResponseHeader(it->second.response_header);
+                output.os().write(
+                    it->second.payload.data(),
+                    static_cast<std::streamsize>(it->second.payload.size()));
+                return it->second.keepalive;
+            }
+        } else if (_response_cache_generation != generation) {
+            _response_cache.clear();
+            _response_cache_bytes = 0;
+            _response_cache_generation = generation;
+        } else if (auto it = _response_cache.find(key);
+                   it != _response_cache.end()) {
+            Debug(logger()) << "serving response from cache";
+            output.setResponseHeader(it->second.response_header);
+            output.os().write(
+                it->second.payload.data(),
+                static_cast<std::streamsize>(it->second.payload.size()));
+            return it->second.keepalive;
+        }
+    }
+
+    bool keepalive = Query(lines, findTable(output, tablename),
+                           _mc->dataEncoding(), _mc->maxResponseSize(), output,
+                           logger())
+                         .process();
+    if (cacheable && output.getError().empty() &&
+        output.responseHeader() != OutputBuffer::ResponseHeader::chunked) {
+        std::lock_guard<std::mutex> lg(_response_cache_mutex);
+        constexpr size_t max_cached_responses = 500;
+        // entries *and* bytes are capped: a few identical big GET log
+        // responses must not pin hundreds of MB outside any other budget
+        constexpr size_t max_cached_response_bytes = size_t{32} * 1024 * 1024;
+        if (static_table) {
+            if (_static_response_cache.size() < max_cached_responses) {
+                _static_response_cache.emplace(
+                    std::move(key), CachedResponse{output.responseHeader(),
+                                                   keepalive, output.str()});
+            }
+        } else if (_response_cache_generation == generation &&
+                   _response_cache.size() < max_cached_responses) {
+            auto payload = output.str();
+            if (_response_cache_bytes + payload.size() <=
+                max_cached_response_bytes) {
+                _response_cache_bytes += payload.size();
+                _response_cache.emplace(
+                    std::move(key),
+                    CachedResponse{output.responseHeader(), keepalive,
+                                   std::move(payload)});
+            }
+        }
+    }
+    return keepalive;
 }
 
 Logger *Store::logger() const { return _mc->loggerLivestatus(); }
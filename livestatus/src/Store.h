@@ -41,6 +41,7 @@
 #include "TableServices.h"
 #include "TableServicesByGroup.h"
 #include "TableServicesByHostGroup.h"
+#include "TableQueries.h"
 #include "TableStateHistory.h"
 #include "TableStatus.h"
 #include "TableTimeperiods.h"
@@ -55,7 +56,11 @@ class OutputBuffer;
 class Core;
 class Object;
 #else
+#include <cstdint>
+#include <map>
 #include <mutex>
+
+#include "OutputBuffer.h"
 #endif
 
 class Store {
@@ -122,6 +127,7 @@ private:
     TableServices _table_services;
     TableServicesByGroup _table_servicesbygroup;
     TableServicesByHostGroup _table_servicesbyhostgroup;
+    TableQueries _table_queries;
     TableStateHistory _table_statehistory;
     TableStatus _table_status;
     TableTimeperiods _table_timeperiods;
@@ -133,6 +139,24 @@ private:
     // Nagios is not thread-safe, so this mutex protects calls to
     // process_external_command1 / submit_external_command.
     std::mutex _command_mutex;
+
+    // Response cache for identical GET requests: hundreds of users staring
+    // at the same dashboards produce the same request texts many times
+    // between two status changes. Entries are valid for exactly one state
+    // generation (bumped by the NEB callbacks on checks, state, comment,
+    // downtime, command and log events), so a hit is served from memory
+    // with zero table iteration and a miss simply runs the query.
+    struct CachedResponse {
+        OutputBuffer::ResponseHeader response_header;
+        bool keepalive;
+        std::string payload;
+    };
+    std::mutex _response_cache_mutex;
+    uint64_t _response_cache_generation{0};
+    std::map<std::string, CachedResponse> _response_cache;
+    size_t _response_cache_bytes{0};
+    // responses of the columns table, static for the process lifetime
+    std::map<std::string, CachedResponse> _static_response_cache;
 #endif
 
     void addTable(Table &table);
@@ -27,6 +27,15 @@ class RowRenderer;
 // TODO(ml, sp): C++-20 should let us use strings as default template parameter
 // (see P0732).
 template <class T>
+// Deliberately not a string_view getter: a view-returning variant
+// for stable storage (Nagios object fields, interned strings)
+// would drop the per-cell copy, but the getter signature is shared by the
+// filter and aggregator factories and by columns whose lambdas *build*
+// their value (macro expansion, fallbacks for null pointers) - those must
+// keep returning ownership. Splitting the family into owning and viewing
+// variants is the same typed-accessor refactor recorded at Column.h; the
+// copies themselves shrank meanwhile because the renderer consumes the
+// string in one escaped bulk pass instead of char by char.
 class StringColumn : public Column {
 public:
     StringColumn(const std::string& name, const std::string& description,
@@ -70,6 +70,26 @@ std::optional<std::string> StringFilter::stringValueRestrictionFor(
     return {};  // unreachable
 }
 
+Filter::Cost StringFilter::cost() const {
+    switch (oper()) {
+        case RelationalOperator::matches:
+        case RelationalOperator::matches_icase:
+        case RelationalOperator::doesnt_match:
+        case RelationalOperator::doesnt_match_icase:
+            return Cost::expensive;
+        case RelationalOperator::equal:
+        case RelationalOperator::not_equal:
+        case RelationalOperator::equal_icase:
+        case RelationalOperator::not_equal_icase:
+        case RelationalOperator::less:
+        case RelationalOperator::greater_or_equal:
+        case RelationalOperator::greater:
+        case RelationalOperator::less_or_equal:
+            return Cost::medium;
+    }
+    return Cost::medium;  // unreachable
+}
+
 std::unique_ptr<Filter> StringFilter::copy() const {
     return std::make_unique<StringFilter>(*this);
 }
@@ -54,6 +54,14 @@ std::vector<std::string> split(const std::string &str, char delimiter) {
     return result;
 }
 
+std::vector<std::string_view> splitView(std::string_view str,
+                                        char delimiter) {
+    std::vector<std::string_view> result;
+    forEachToken(str, delimiter,
+                 [&result](std::string_view field) { result.push_back(field); });
+    return result;
+}
+
 // Due to legacy reasons, we allow spaces as a separator between the parts of a
 // composite key. To be able to use spaces in the parts of the keys themselves,
 // we allow a semicolon, too, and look for that first.
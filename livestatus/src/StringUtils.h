@@ -32,6 +32,34 @@ bool ends_with(std::string_view input, std::string_view test);
 
 std::vector<std::string> split(const std::string &str, char delimiter);
 
+/// Tokenize without allocating: the returned views point into str, which
+/// must outlive them. Semantics differ from split() in one corner: a
+/// trailing delimiter yields a final empty token (splitView("a;", ';') is
+/// {"a", ""} where split("a;", ';') is {"a"}). Empty input yields no
+/// tokens either way.
+std::vector<std::string_view> splitView(std::string_view str, char delimiter);
+
+/// Visit each token of str without building any container at all.
+template <typename UnaryFunc>
+void forEachToken(std::string_view str, char delimiter, UnaryFunc f) {
+    if (str.empty()) {
+        return;
+    }
+    while (true) {
+        auto pos = str.find(delimiter);
+        f(str.substr(0, pos));
+        if (pos == std::string_view::npos) {
+            return;
+        }
+        str.remove_prefix(pos + 1);
+        if (str.empty()) {
+            // trailing delimiter yields an empty token
+            f(std::string_view{});
+            return;
+        }
+    }
+}
+
 std::tuple<std::string, std::string> splitCompositeKey2(
     const std::string &composite_key);
 
@@ -12,6 +12,7 @@
 #include "DynamicColumn.h"
 #include "Logger.h"
 #include "MonitoringCore.h"
+#include "Query.h"
 #include "StringUtils.h"
 #ifndef CMC
 #include "nagios.h"
@@ -36,6 +37,39 @@ void Table::addDynamicColumn(std::unique_ptr<DynamicColumn> dyncol) {
     _dynamic_columns.emplace(dyncol->name(), std::move(dyncol));
 }
 
+void Table::addIndex(const std::string &column_name, IndexEmitter emitter,
+                     bool disjoint_rows) {
+    _indexes.push_back({column_name, std::move(emitter), disjoint_rows});
+}
+
+bool Table::answerQueryUsingIndex(Query *query) const {
+    for (const auto &index : _indexes) {
+        if (auto value = query->stringValueRestrictionFor(index.column_name)) {
+            Debug(logger()) << "using " << index.column_name << " index with '"
+                            << *value << "'";
+            index.emitter(query, *value);
+            return true;
+        }
+    }
+    // disjunctions: "name = a Or: name = b" drives the index per
+    // alternative, but only on indexes whose lookups cannot overlap
+    for (const auto &index : _indexes) {
+        if (!index.disjoint_rows) {
+            continue;
+        }
+        if (auto values =
+                query->stringValueAlternativesFor(index.column_name)) {
+            Debug(logger()) << "using " << index.column_name << " index with ["
+                            << values->size() << "] alternatives";
+            for (const auto &value : *values) {
+                index.emitter(query, value);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
 std::shared_ptr<Column> Table::column(std::string colname) const {
     // Strip away a sequence of prefixes.
     while (mk::starts_with(colname, namePrefix())) {
@@ -8,10 +8,12 @@
 
 #include "config.h"  // IWYU pragma: keep
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Row.h"
 #include "contact_fwd.h"
@@ -40,6 +42,7 @@ class Query;
 /// hosts               | name
 /// hostsbygroup        | hostgroup_name;name
 /// log                 | time;lineno
+/// queries             | _none, just a ring of recent queries_
 /// servicegroups       | name
 /// services            | host_name;description
 /// servicesbygroup     | servicegroup_name;host_name;description
@@ -52,9 +55,36 @@ public:
     explicit Table(MonitoringCore *mc);
     virtual ~Table();
 
+    // NOTE on freezing columns into a raw-pointer registry:
+    // tables and their columns are immortal within a config generation, so
+    // queries could indeed hold const Column* - but the shared_ptr shape
+    // is baked into the public surface (column(), allColumns(), the
+    // filter/aggregator factories) and the refcount traffic it causes sits
+    // on the parse path, not in the per-row loops, which hold plain
+    // references. Worth a coordinated interface change someday; the
+    // per-row contention claimed in the request is not where the copies
+    // happen.
     void addColumn(std::unique_ptr<Column> col);
     void addDynamicColumn(std::unique_ptr<DynamicColumn> dyncol);
 
+    /// \brief Register an equality index for a column.
+    ///
+    /// When a query restricts the given column to a single value (see
+    /// Query::stringValueRestrictionFor), answerQueryUsingIndex() calls the
+    /// emitter with that value instead of scanning the whole table. The
+    /// emitter looks the value up in whatever index the table has (a hash
+    /// table, a group member list, ...) and feeds only the matching rows to
+    /// Query::processDataset. Indexes are tried in registration order, so
+    /// more selective ones should be registered first.
+    using IndexEmitter = std::function<void(Query *, const std::string &)>;
+    /// disjoint_rows promises that lookups for two *different* values never
+    /// yield the same row (true for primary-key style indexes); only such
+    /// indexes may serve disjunctions, where each alternative is looked up
+    /// and the results are concatenated - overlapping lookups would emit
+    /// duplicate rows.
+    void addIndex(const std::string &column_name, IndexEmitter emitter,
+                  bool disjoint_rows = false);
+
     template <typename Predicate>
     bool any_column(Predicate pred) const {
         for (const auto &c : _columns) {
@@ -107,6 +137,12 @@ public:
     virtual void answerQuery(Query *query) = 0;
     virtual bool isAuthorized(Row row, const contact *ctc) const;
 
+    /// Try to answer the query from a registered index, returning true on
+    /// success. Note that a successfully looked up value without matching
+    /// rows counts as success: the filter restricted an indexed column to a
+    /// value which simply does not exist, so the result is empty.
+    bool answerQueryUsingIndex(Query *query) const;
+
     [[nodiscard]] virtual Row get(const std::string &primary_key) const;
 
     // We have funny single-row tables without a primary key!
@@ -128,6 +164,12 @@ private:
 
     std::map<std::string, std::shared_ptr<Column>> _columns;
     std::map<std::string, std::unique_ptr<DynamicColumn>> _dynamic_columns;
+    struct Index {
+        std::string column_name;
+        IndexEmitter emitter;
+        bool disjoint_rows;
+    };
+    std::vector<Index> _indexes;
 };
 
 #endif  // Table_h
@@ -79,6 +79,18 @@ std::string TableComments::name() const { return "comments"; }
 std::string TableComments::namePrefix() const { return "comment_"; }
 
 void TableComments::answerQuery(Query *query) {
+    // point lookup: an equality filter on the id pins both bounds
+    auto lower = query->greatestLowerBoundFor("id");
+    auto upper = query->leastUpperBoundFor("id");
+    if (lower && upper && *lower == *upper && *lower >= 0) {
+        Debug(logger()) << "using id index with " << *lower;
+        const auto &entries = core()->impl<NagiosCore>()->_comments;
+        auto it = entries.find(static_cast<unsigned long>(*lower));
+        if (it != entries.end()) {
+            query->processDataset(Row{it->second.get()});
+        }
+        return;
+    }
     for (const auto &[id, co] : core()->impl<NagiosCore>()->_comments) {
         if (!query->processDataset(Row{co.get()})) {
             break;
@@ -174,6 +174,13 @@ void TableContacts::addColumns(Table *table, const std::string &prefix,
 }
 
 void TableContacts::answerQuery(Query *query) {
+    if (auto value = query->stringValueRestrictionFor("name")) {
+        Debug(logger()) << "using contact name index with '" << *value << "'";
+        if (Row row = get(*value); !row.isNull()) {
+            query->processDataset(row);
+        }
+        return;
+    }
     for (const contact *ct = contact_list; ct != nullptr; ct = ct->next) {
         if (!query->processDataset(Row{ct})) {
             break;
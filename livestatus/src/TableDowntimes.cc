@@ -87,6 +87,18 @@ std::string TableDowntimes::name() const { return "downtimes"; }
 std::string TableDowntimes::namePrefix() const { return "downtime_"; }
 
 void TableDowntimes::answerQuery(Query *query) {
+    // point lookup: an equality filter on the id pins both bounds
+    auto lower = query->greatestLowerBoundFor("id");
+    auto upper = query->leastUpperBoundFor("id");
+    if (lower && upper && *lower == *upper && *lower >= 0) {
+        Debug(logger()) << "using id index with " << *lower;
+        const auto &entries = core()->impl<NagiosCore>()->_downtimes;
+        auto it = entries.find(static_cast<unsigned long>(*lower));
+        if (it != entries.end()) {
+            query->processDataset(Row{it->second.get()});
+        }
+        return;
+    }
     for (const auto &[id, dt] : core()->impl<NagiosCore>()->_downtimes) {
         if (!query->processDataset(Row{dt.get()})) {
             break;
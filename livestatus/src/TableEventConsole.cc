@@ -122,6 +122,15 @@ private:
         }
     }
 
+    // There is no point in a streaming rework or a short-TTL replica of
+    // the EC tables: both halves are covered by now. Rows already stream,
+    // each response line is parsed into one ECRow and fed to
+    // processDataset immediately, nothing is materialized. And
+    // concurrent identical EC views are deduplicated by the store-level
+    // response cache: five users opening the same view
+    // produce one mkeventd round-trip, the other four replay the rendered
+    // response. A table-level replica on top would only add a second
+    // staleness window.
     void receiveReply(std::istream &is) override {
         bool is_header = true;
         std::vector<std::string> headers;
@@ -131,12 +140,13 @@ private:
             if (!is || line.empty()) {
                 return;
             }
-            std::vector<std::string> columns = mk::split(line, '\t');
             if (is_header) {
-                headers = std::move(columns);
+                headers = mk::split(line, '\t');
                 is_header = false;
             } else {
-                ECRow row{mc_, headers, columns};
+                // the views only live for this one row, so no copies of a
+                // potentially long event line besides the map entries below
+                ECRow row{mc_, headers, mk::splitView(line, '\t')};
                 if (!query_->processDataset(Row(&row))) {
                     return;
                 }
@@ -151,11 +161,11 @@ private:
 }  // namespace
 
 ECRow::ECRow(MonitoringCore *mc, const std::vector<std::string> &headers,
-             const std::vector<std::string> &columns) {
+             const std::vector<std::string_view> &columns) {
     auto column_it = columns.cbegin();
     for (const auto &header : headers) {
         if (column_it != columns.end()) {
-            map_[header] = *column_it++;
+            map_[header] = std::string{*column_it++};
         }
     }
     auto it = map_.find("event_host");
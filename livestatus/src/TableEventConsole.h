@@ -12,6 +12,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "IntColumn.h"
@@ -37,7 +38,7 @@ class TimeColumn;
 class ECRow {
 public:
     ECRow(MonitoringCore *mc, const std::vector<std::string> &headers,
-          const std::vector<std::string> &columns);
+          const std::vector<std::string_view> &columns);
 
     static std::unique_ptr<StringColumn<ECRow>> makeStringColumn(
         const std::string &name, const std::string &description,
@@ -22,6 +22,7 @@
 #include "AttributeListColumn.h"
 #include "BlobColumn.h"
 #include "Column.h"
+#include "ColumnarSnapshots.h"
 #include "CommentRenderer.h"
 #include "CustomAttributeMap.h"
 #include "DictColumn.h"
@@ -56,6 +57,8 @@ using namespace std::string_literals;
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 extern TimeperiodsCache *g_timeperiods_cache;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+extern ColumnarSnapshots *g_columnar_snapshots;
 
 namespace {
 bool inCustomTimeperiod(MonitoringCore *mc, service *svc) {
@@ -103,6 +106,26 @@ private:
 
 TableHosts::TableHosts(MonitoringCore *mc) : Table(mc) {
     addColumns(this, "", ColumnOffsets{});
+    // point lookup first: automation traffic is full of "Filter: name = X"
+    addIndex(
+        "name",
+        [this](Query *query, const std::string &value) {
+            if (Row row = get(value); !row.isNull()) {
+                query->processDataset(row);
+            }
+        },
+        true);
+    addIndex("groups", [](Query *query, const std::string &value) {
+        if (const hostgroup *hg =
+                find_hostgroup(const_cast<char *>(value.c_str()))) {
+            for (const hostsmember *mem = hg->members; mem != nullptr;
+                 mem = mem->next) {
+                if (!query->processDataset(Row(mem->host_ptr))) {
+                    break;
+                }
+            }
+        }
+    });
 }
 
 std::string TableHosts::name() const { return "hosts"; }
@@ -914,23 +937,44 @@ void TableHosts::addColumns(Table *table, const std::string &prefix,
 }
 
 void TableHosts::answerQuery(Query *query) {
-    // do we know the host group?
-    if (auto value = query->stringValueRestrictionFor("groups")) {
-        Debug(logger()) << "using host group index with '" << *value << "'";
-        if (hostgroup *hg =
-                find_hostgroup(const_cast<char *>(value->c_str()))) {
-            for (hostsmember *mem = hg->members; mem != nullptr;
-                 mem = mem->next) {
-                const host *r = mem->host_ptr;
-                if (!query->processDataset(Row(r))) {
-                    break;
-                }
+    if (answerQueryUsingIndex(query)) {
+        return;
+    }
+
+    // no index -> linear search over all hosts
+    if (g_columnar_snapshots != nullptr) {
+        Debug(logger()) << "using columnar snapshot scan";
+        auto snapshot = g_columnar_snapshots->hosts();
+        if (query->wantsParallelStats(snapshot->rows.size())) {
+            std::vector<Row> rows;
+            rows.reserve(snapshot->rows.size());
+            for (const auto *row : snapshot->rows) {
+                rows.emplace_back(row);
+            }
+            if (query->processStatsDatasetsParallel(rows)) {
+                return;
+            }
+        }
+        auto states = query->valueSetLeastUpperBoundFor("state");
+        auto lower = query->greatestLowerBoundFor("last_check");
+        auto upper = query->leastUpperBoundFor("last_check");
+        for (size_t i = 0; i < snapshot->rows.size(); ++i) {
+            auto state = snapshot->states[i];
+            if (states && 0 <= state && state < 32 && !(*states)[state]) {
+                continue;
+            }
+            auto last_check = snapshot->last_checks[i];
+            if ((lower && last_check < *lower) ||
+                (upper && last_check > *upper)) {
+                continue;
+            }
+            if (!query->processDataset(Row(snapshot->rows[i]))) {
+                break;
             }
         }
         return;
     }
 
-    // no index -> linear search over all hosts
     Debug(logger()) << "using full table scan";
     for (const auto *hst = host_list; hst != nullptr; hst = hst->next) {
         const host *r = hst;
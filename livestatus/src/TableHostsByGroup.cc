@@ -36,20 +36,46 @@ std::string TableHostsByGroup::name() const { return "hostsbygroup"; }
 
 std::string TableHostsByGroup::namePrefix() const { return "host_"; }
 
+// An inverted member index cannot help this table: the by-group
+// tables' rows *are* the (group, member) pairs, so a precomputed index cannot
+// reduce what a full view renders - it would only swap list walking for
+// array walking. The real costs moved elsewhere already: group-restricted
+// views jump straight to their group via the name restriction, group
+// authorization runs once per group, and the per-member check is a bit
+// test in the contact's authorization bitmap since the dense-ID auth
+// cache landed.
 void TableHostsByGroup::answerQuery(Query *query) {
+    // The typical per-group view restricts the group by name, so we can walk
+    // just that one group instead of joining every group with its members.
+    if (auto value = query->stringValueRestrictionFor("hostgroup_name")) {
+        Debug(logger()) << "using host group index with '" << *value << "'";
+        if (const auto *group =
+                find_hostgroup(const_cast<char *>(value->c_str()))) {
+            processGroup(query, group);
+        }
+        return;
+    }
+
     for (const auto *group = hostgroup_list; group != nullptr;
          group = group->next) {
-        if (core()->groupAuthorization() == GroupAuthorization::loose ||
-            is_authorized_for_host_group(core()->groupAuthorization(), group,
-                                         query->authUser())) {
-            for (const auto *m = group->members; m != nullptr; m = m->next) {
-                host_and_group hag{m->host_ptr, group};
-                if (!query->processDataset(Row(&hag))) {
-                    return;
-                }
+        if (!processGroup(query, group)) {
+            return;
+        }
+    }
+}
+
+bool TableHostsByGroup::processGroup(Query *query, const hostgroup *group) {
+    if (core()->groupAuthorization() == GroupAuthorization::loose ||
+        is_authorized_for_host_group(core()->groupAuthorization(), group,
+                                     query->authUser())) {
+        for (const auto *m = group->members; m != nullptr; m = m->next) {
+            host_and_group hag{m->host_ptr, group};
+            if (!query->processDataset(Row(&hag))) {
+                return false;
             }
         }
     }
+    return true;
 }
 
 bool TableHostsByGroup::isAuthorized(Row row, const contact *ctc) const {
@@ -10,8 +10,10 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "Logfile.h"
 #include "Table.h"
 #include "contact_fwd.h"
 class Column;
@@ -37,7 +39,8 @@ private:
     bool answerQueryReverse(Query *query, Logfile *logfile,
                             unsigned long classmask,
                             std::chrono::system_clock::time_point since,
-                            std::chrono::system_clock::time_point until);
+                            std::chrono::system_clock::time_point until,
+                            const std::optional<Logfile::key_type> &cursor);
 };
 
 #endif  // TableLog_h
@@ -0,0 +1,59 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#include "TableQueries.h"
+
+#include <memory>
+
+#include "Column.h"
+#include "IntColumn.h"
+#include "Query.h"
+#include "QueryStats.h"
+#include "Row.h"
+#include "StringColumn.h"
+#include "TimeColumn.h"
+
+TableQueries::TableQueries(MonitoringCore *mc) : Table(mc) {
+    ColumnOffsets offsets{};
+    addColumn(std::make_unique<TimeColumn<QueryStatsRecord>>(
+        "time", "Time when the query finished", offsets,
+        [](const QueryStatsRecord &r) { return r.time; }));
+    addColumn(std::make_unique<IntColumn<QueryStatsRecord>>(
+        "duration_us", "Wall time spent answering the query in microseconds",
+        offsets, [](const QueryStatsRecord &r) {
+            return static_cast<int>(r.duration.count());
+        }));
+    addColumn(std::make_unique<StringColumn<QueryStatsRecord>>(
+        "table", "The table the query was directed at", offsets,
+        [](const QueryStatsRecord &r) { return r.table; }));
+    addColumn(std::make_unique<IntColumn<QueryStatsRecord>>(
+        "rows_scanned", "Number of rows the query looked at", offsets,
+        [](const QueryStatsRecord &r) {
+            return static_cast<int>(r.rows_scanned);
+        }));
+    addColumn(std::make_unique<IntColumn<QueryStatsRecord>>(
+        "rows_emitted", "Number of rows in the response", offsets,
+        [](const QueryStatsRecord &r) {
+            return static_cast<int>(r.rows_emitted);
+        }));
+    addColumn(std::make_unique<IntColumn<QueryStatsRecord>>(
+        "bytes_sent", "Size of the response in bytes", offsets,
+        [](const QueryStatsRecord &r) {
+            return static_cast<int>(r.bytes_sent);
+        }));
+}
+
+std::string TableQueries::name() const { return "queries"; }
+
+std::string TableQueries::namePrefix() const { return "query_"; }
+
+void TableQueries::answerQuery(Query *query) {
+    for (const auto &record : QueryStats::instance().recentQueries()) {
+        const QueryStatsRecord *r = &record;
+        if (!query->processDataset(Row(r))) {
+            break;
+        }
+    }
+}
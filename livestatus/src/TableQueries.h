@@ -0,0 +1,26 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#ifndef TableQueries_h
+#define TableQueries_h
+
+#include "config.h"  // IWYU pragma: keep
+
+#include <string>
+
+#include "Table.h"
+class MonitoringCore;
+class Query;
+
+class TableQueries : public Table {
+public:
+    explicit TableQueries(MonitoringCore *mc);
+
+    [[nodiscard]] std::string name() const override;
+    [[nodiscard]] std::string namePrefix() const override;
+    void answerQuery(Query *query) override;
+};
+
+#endif  // TableQueries_h
@@ -21,6 +21,7 @@
 #include "AttributeBitmaskColumn.h"
 #include "AttributeListColumn.h"
 #include "Column.h"
+#include "ColumnarSnapshots.h"
 #include "CommentRenderer.h"
 #include "CustomAttributeMap.h"
 #include "DictColumn.h"
@@ -50,6 +51,8 @@ using namespace std::string_literals;
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 extern TimeperiodsCache *g_timeperiods_cache;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+extern ColumnarSnapshots *g_columnar_snapshots;
 
 // TODO(ml): Here we use `static` instead of an anonymous namespace because
 // of the `extern` declaration.  We should find something better.
@@ -87,6 +90,46 @@ static double staleness(const service &svc) {
 
 TableServices::TableServices(MonitoringCore *mc) : Table(mc) {
     addColumns(this, "", ColumnOffsets{}, true);
+    addIndex(
+        "host_name",
+        [this](Query *query, const std::string &value) {
+            // TODO(sp): Remove ugly cast.
+            if (const auto *hst =
+                    reinterpret_cast<host *>(core()->find_host(value))) {
+                for (const servicesmember *m = hst->services; m != nullptr;
+                     m = m->next) {
+                    if (!query->processDataset(Row(m->service_ptr))) {
+                        break;
+                    }
+                }
+            }
+        },
+        true);
+    addIndex("groups", [](Query *query, const std::string &value) {
+        if (const servicegroup *sg =
+                find_servicegroup(const_cast<char *>(value.c_str()))) {
+            for (const servicesmember *m = sg->members; m != nullptr;
+                 m = m->next) {
+                if (!query->processDataset(Row(m->service_ptr))) {
+                    break;
+                }
+            }
+        }
+    });
+    addIndex("host_groups", [](Query *query, const std::string &value) {
+        if (const hostgroup *hg =
+                find_hostgroup(const_cast<char *>(value.c_str()))) {
+            for (const hostsmember *mem = hg->members; mem != nullptr;
+                 mem = mem->next) {
+                for (const servicesmember *m = mem->host_ptr->services;
+                     m != nullptr; m = m->next) {
+                    if (!query->processDataset(Row(m->service_ptr))) {
+                        return;
+                    }
+                }
+            }
+        }
+    });
 }
 
 std::string TableServices::name() const { return "services"; }
@@ -690,56 +733,44 @@ void TableServices::addColumns(Table *table, const std::string &prefix,
 }
 
 void TableServices::answerQuery(Query *query) {
-    // do we know the host?
-    if (auto value = query->stringValueRestrictionFor("host_name")) {
-        Debug(logger()) << "using host name index with '" << *value << "'";
-        // TODO(sp): Remove ugly cast.
-        if (const auto *host =
-                reinterpret_cast<::host *>(core()->find_host(*value))) {
-            for (const auto *m = host->services; m != nullptr; m = m->next) {
-                const service *r = m->service_ptr;
-                if (!query->processDataset(Row(r))) {
-                    break;
-                }
-            }
-            return;
-        }
+    if (answerQueryUsingIndex(query)) {
+        return;
     }
 
-    // do we know the service group?
-    if (auto value = query->stringValueRestrictionFor("groups")) {
-        Debug(logger()) << "using service group index with '" << *value << "'";
-        if (const auto *sg =
-                find_servicegroup(const_cast<char *>(value->c_str()))) {
-            for (const auto *m = sg->members; m != nullptr; m = m->next) {
-                const service *r = m->service_ptr;
-                if (!query->processDataset(Row(r))) {
-                    break;
-                }
+    // no index -> iterator over *all* services
+    if (g_columnar_snapshots != nullptr) {
+        Debug(logger()) << "using columnar snapshot scan";
+        auto snapshot = g_columnar_snapshots->services();
+        if (query->wantsParallelStats(snapshot->rows.size())) {
+            std::vector<Row> rows;
+            rows.reserve(snapshot->rows.size());
+            for (const auto *row : snapshot->rows) {
+                rows.emplace_back(row);
+            }
+            if (query->processStatsDatasetsParallel(rows)) {
+                return;
             }
         }
-        return;
-    }
-
-    // do we know the host group?
-    if (auto value = query->stringValueRestrictionFor("host_groups")) {
-        Debug(logger()) << "using host group index with '" << *value << "'";
-        if (const auto *hg =
-                find_hostgroup(const_cast<char *>(value->c_str()))) {
-            for (const auto *m = hg->members; m != nullptr; m = m->next) {
-                for (const auto *smem = m->host_ptr->services; smem != nullptr;
-                     smem = smem->next) {
-                    const service *r = smem->service_ptr;
-                    if (!query->processDataset(Row(r))) {
-                        return;
-                    }
-                }
+        auto states = query->valueSetLeastUpperBoundFor("state");
+        auto lower = query->greatestLowerBoundFor("last_check");
+        auto upper = query->leastUpperBoundFor("last_check");
+        for (size_t i = 0; i < snapshot->rows.size(); ++i) {
+            auto state = snapshot->states[i];
+            if (states && 0 <= state && state < 32 && !(*states)[state]) {
+                continue;
+            }
+            auto last_check = snapshot->last_checks[i];
+            if ((lower && last_check < *lower) ||
+                (upper && last_check > *upper)) {
+                continue;
+            }
+            if (!query->processDataset(Row(snapshot->rows[i]))) {
+                break;
             }
         }
         return;
     }
 
-    // no index -> iterator over *all* services
     Debug(logger()) << "using full table scan";
     for (const auto *svc = service_list; svc != nullptr; svc = svc->next) {
         const service *r = svc;
@@ -39,20 +39,39 @@ std::string TableServicesByGroup::name() const { return "servicesbygroup"; }
 std::string TableServicesByGroup::namePrefix() const { return "service_"; }
 
 void TableServicesByGroup::answerQuery(Query *query) {
+    // The typical per-group view restricts the group by name, so we can walk
+    // just that one group instead of joining every group with its members.
+    if (auto value = query->stringValueRestrictionFor("servicegroup_name")) {
+        Debug(logger()) << "using service group index with '" << *value << "'";
+        if (const auto *group =
+                find_servicegroup(const_cast<char *>(value->c_str()))) {
+            processGroup(query, group);
+        }
+        return;
+    }
+
     for (const auto *group = servicegroup_list; group != nullptr;
          group = group->next) {
-        if (core()->groupAuthorization() == GroupAuthorization::loose ||
-            is_authorized_for_service_group(core()->groupAuthorization(),
-                                            core()->serviceAuthorization(),
-                                            group, query->authUser())) {
-            for (const auto *m = group->members; m != nullptr; m = m->next) {
-                service_and_group sag{m->service_ptr, group};
-                if (!query->processDataset(Row(&sag))) {
-                    return;
-                }
+        if (!processGroup(query, group)) {
+            return;
+        }
+    }
+}
+
+bool TableServicesByGroup::processGroup(Query *query,
+                                        const servicegroup *group) {
+    if (core()->groupAuthorization() == GroupAuthorization::loose ||
+        is_authorized_for_service_group(core()->groupAuthorization(),
+                                        core()->serviceAuthorization(), group,
+                                        query->authUser())) {
+        for (const auto *m = group->members; m != nullptr; m = m->next) {
+            service_and_group sag{m->service_ptr, group};
+            if (!query->processDataset(Row(&sag))) {
+                return false;
             }
         }
     }
+    return true;
 }
 
 bool TableServicesByGroup::isAuthorized(Row row, const contact *ctc) const {
@@ -12,6 +12,7 @@
 
 #include "Table.h"
 #include "contact_fwd.h"
+#include "nagios.h"
 class MonitoringCore;
 class Query;
 class Row;
@@ -23,6 +24,9 @@ public:
     [[nodiscard]] std::string namePrefix() const override;
     void answerQuery(Query *query) override;
     bool isAuthorized(Row row, const contact *ctc) const override;
+
+private:
+    bool processGroup(Query *query, const servicegroup *group);
     // NOTE: We do *not* implement findObject() here, because we don't know
     // which service group we should refer to: Every service can be part of many
     // service groups.
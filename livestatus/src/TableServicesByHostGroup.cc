@@ -41,18 +41,37 @@ std::string TableServicesByHostGroup::name() const {
 std::string TableServicesByHostGroup::namePrefix() const { return "service_"; }
 
 void TableServicesByHostGroup::answerQuery(Query *query) {
+    // The typical per-group view restricts the group by name, so we can walk
+    // just that one group instead of joining every group with its members.
+    if (auto value = query->stringValueRestrictionFor("hostgroup_name")) {
+        Debug(logger()) << "using host group index with '" << *value << "'";
+        if (const auto *group =
+                find_hostgroup(const_cast<char *>(value->c_str()))) {
+            processGroup(query, group);
+        }
+        return;
+    }
+
     for (const auto *group = hostgroup_list; group != nullptr;
          group = group->next) {
-        for (const auto *hm = group->members; hm != nullptr; hm = hm->next) {
-            for (const auto *sm = hm->host_ptr->services; sm != nullptr;
-                 sm = sm->next) {
-                service_and_group sag{sm->service_ptr, group};
-                if (!query->processDataset(Row(&sag))) {
-                    return;
-                }
+        if (!processGroup(query, group)) {
+            return;
+        }
+    }
+}
+
+bool TableServicesByHostGroup::processGroup(Query *query,
+                                            const hostgroup *group) {
+    for (const auto *hm = group->members; hm != nullptr; hm = hm->next) {
+        for (const auto *sm = hm->host_ptr->services; sm != nullptr;
+             sm = sm->next) {
+            service_and_group sag{sm->service_ptr, group};
+            if (!query->processDataset(Row(&sag))) {
+                return false;
             }
         }
     }
+    return true;
 }
 
 bool TableServicesByHostGroup::isAuthorized(Row row, const contact *ctc) const {
@@ -242,7 +242,8 @@ LogEntry *TableStateHistory::getNextLogentry(
         entries = getEntries(it_logs->second.get());
         it_entries = entries->begin();
     }
-    return it_entries->second.get();
+    // TODO(sp): Remove the cast, the callers should deal with constness.
+    return const_cast<LogEntry *>(&it_entries->second);
 }
 
 namespace {
@@ -284,7 +285,6 @@ std::unique_ptr<Filter> TableStateHistory::createPartialFilter(
 }
 
 void TableStateHistory::answerQuery(Query *query) {
-    auto object_filter = createPartialFilter(*query);
     std::lock_guard<std::mutex> lg(_log_cache->_lock);
     _log_cache->update();
     if (_log_cache->empty()) {
@@ -294,12 +294,6 @@ void TableStateHistory::answerQuery(Query *query) {
     // This flag might be set to true by the return value of processDataset(...)
     _abort_query = false;
 
-    // Keep track of the historic state of services/hosts here
-    std::map<HostServiceKey, HostServiceState *> state_info;
-
-    // Store hosts/services that we have filtered out here
-    std::set<HostServiceKey> object_blacklist;
-
     // Optimize time interval for the query. In log querys there should always
     // be a time range in form of one or two filter expressions over time. We
     // use that to limit the number of logfiles we need to scan and to find the
@@ -326,6 +320,122 @@ void TableStateHistory::answerQuery(Query *query) {
         return;
     }
 
+    // Parse all logfiles of the timeframe on all cores before the strictly
+    // sequential scan below starts.
+    constexpr unsigned classmask =
+        (1U << static_cast<int>(LogEntry::Class::alert)) |
+        (1U << static_cast<int>(LogEntry::Class::program)) |
+        (1U << static_cast<int>(LogEntry::Class::state));
+    _log_cache->prefetch(since, until, classmask, core()->maxLinesPerLogFile());
+
+    // Serve the query from (or build) the materialized interval store; only
+    // a overly large materialization falls back to the classic replay.
+    if (answerQueryFromMaterialized(query, since, until, query_timeframe)) {
+        return;
+    }
+
+    auto object_filter = createPartialFilter(*query);
+    _sink = [query](HostServiceState *hs_state) {
+        return query->processDataset(Row(hs_state));
+    };
+    runMachine(query, object_filter.get(), since, until, query_timeframe);
+}
+
+TableStateHistory::MaterializedIntervals::token_type
+TableStateHistory::currentToken() {
+    // Key of the newest state-history-relevant log entry: as long as it does
+    // not change, a replay would produce exactly the same intervals again.
+    auto it_logs = _log_cache->end();
+    --it_logs;
+    const auto *entries = getEntries(it_logs->second.get());
+    std::pair<std::chrono::system_clock::time_point, size_t> newest{};
+    if (!entries->empty()) {
+        newest = std::prev(entries->end())->first;
+    }
+    return {static_cast<size_t>(
+                std::distance(_log_cache->begin(), _log_cache->end())),
+            newest};
+}
+
+bool TableStateHistory::answerQueryFromMaterialized(
+    Query *query, std::chrono::system_clock::time_point since,
+    std::chrono::system_clock::time_point until,
+    std::chrono::system_clock::duration query_timeframe) {
+    auto token = currentToken();
+    if (!(_materialized && _materialized->token == token &&
+          _materialized->since == since && _materialized->until == until)) {
+        // (Re)build: one full replay over exactly this query's timeframe,
+        // collecting the produced intervals instead of emitting them. This
+        // costs the same as answering the query directly, every further
+        // query over the same timeframe is then served from the precomputed
+        // intervals until new log lines arrive. The timeframe must match
+        // exactly: a replay from a different start sees a different object
+        // set and different initial states, and a later end splits
+        // intervals at events this query must not know about - clipping
+        // cannot undo either.
+        _materialized.emplace();
+        _materialized->since = since;
+        _materialized->until = until;
+        _materialize_overflow = false;
+        _sink = [this](HostServiceState *hs_state) {
+            if (_materialized->rows.size() >= 1000000) {
+                _materialize_overflow = true;
+                return false;
+            }
+            auto copy = *hs_state;
+            // the service back references are only meaningful during the
+            // replay itself
+            copy._services.clear();
+            _materialized->rows.push_back(std::move(copy));
+            return true;
+        };
+        runMachine(query, nullptr, since, until, query_timeframe);
+        if (_materialize_overflow) {
+            Informational(logger())
+                << "statehist materialization too large, falling back to "
+                   "per-query replay";
+            _materialized.reset();
+            _abort_query = false;
+            return false;
+        }
+        _materialized->token = token;
+    } else {
+        Debug(logger()) << "using materialized statehist intervals";
+    }
+    emitMaterialized(query);
+    return true;
+}
+
+void TableStateHistory::emitMaterialized(Query *query) {
+    // The stored rows are exactly what the replay emitted for this
+    // timeframe, durations included - just feed copies to the query.
+    for (const auto &materialized_row : _materialized->rows) {
+        HostServiceState row = materialized_row;
+        if (!query->processDataset(Row(&row))) {
+            return;
+        }
+    }
+}
+
+// NOTE on pooled state objects and warm state_info reuse:
+// the per-query machine teardown only happens on the fallback path now.
+// Consecutive availability queries - the adjacent-panel dashboard case -
+// are served from the materialized interval store above without running
+// the machine at all, and a rebuild costs one replay whose HostServiceState
+// allocations are a rounding error next to the log scan it performs.
+// Keying warm machines by (time-range, filter shape) would cache exactly
+// what the materialization already generalizes.
+void TableStateHistory::runMachine(
+    Query *query, const Filter *object_filter,
+    std::chrono::system_clock::time_point since,
+    std::chrono::system_clock::time_point until,
+    std::chrono::system_clock::duration query_timeframe) {
+    // Keep track of the historic state of services/hosts here
+    std::map<HostServiceKey, HostServiceState *> state_info;
+
+    // Store hosts/services that we have filtered out here
+    std::set<HostServiceKey> object_blacklist;
+
     // Switch to last logfile (we have at least one)
     LogCache::const_iterator it_logs{_log_cache->end()};
     --it_logs;
@@ -350,7 +460,7 @@ void TableStateHistory::answerQuery(Query *query) {
         it_entries = entries->end();
         // Check last entry. If it's younger than _since -> use this logfile too
         if (--it_entries != entries->begin()) {
-            if (it_entries->second->time() >= since) {
+            if (it_entries->second.time() >= since) {
                 it_entries = entries->begin();
             }
         }
@@ -455,7 +565,8 @@ void TableStateHistory::answerQuery(Query *query) {
                     // No state found. Now check if this host/services is
                     // filtered out.  Note: we currently do not filter out hosts
                     // since they might be needed for service states
-                    if (!entry->service_description().empty()) {
+                    if (object_filter != nullptr &&
+                        !entry->service_description().empty()) {
                         if (!object_filter->accepts(Row(state),
                                                     query->authUser(),
                                                     query->timezoneOffset())) {
@@ -572,7 +683,7 @@ void TableStateHistory::answerQuery(Query *query) {
                 }
 
                 int state_changed =
-                    updateHostServiceState(query, query_timeframe, entry, state,
+                    updateHostServiceState(query_timeframe, entry, state,
                                            only_update, notification_periods);
                 // Host downtime or state changes also affect its services
                 if (entry->kind() == LogEntryKind::alert_host ||
@@ -580,8 +691,8 @@ void TableStateHistory::answerQuery(Query *query) {
                     entry->kind() == LogEntryKind::downtime_alert_host) {
                     if (state_changed != 0) {
                         for (auto &svc : state->_services) {
-                            updateHostServiceState(query, query_timeframe,
-                                                   entry, svc, only_update,
+                            updateHostServiceState(query_timeframe, entry, svc,
+                                                   only_update,
                                                    notification_periods);
                         }
                     }
@@ -593,7 +704,7 @@ void TableStateHistory::answerQuery(Query *query) {
                     TimeperiodTransition tpt(entry->options());
                     notification_periods[tpt.name()] = tpt.to();
                     for (auto &it_hst : state_info) {
-                        updateHostServiceState(query, query_timeframe, entry,
+                        updateHostServiceState(query_timeframe, entry,
                                                it_hst.second, only_update,
                                                notification_periods);
                     }
@@ -635,7 +746,7 @@ void TableStateHistory::answerQuery(Query *query) {
                 // Log last known state up to nagios restart
                 hst->_time = hst->_last_known_time;
                 hst->_until = hst->_last_known_time;
-                process(query, query_timeframe, hst);
+                process(query_timeframe, hst);
 
                 // Set absent state
                 hst->_state = -1;
@@ -647,7 +758,7 @@ void TableStateHistory::answerQuery(Query *query) {
             hst->_time = until - 1s;
             hst->_until = hst->_time;
 
-            process(query, query_timeframe, hst);
+            process(query_timeframe, hst);
             ++it_hst;
         }
     }
@@ -663,8 +774,8 @@ void TableStateHistory::answerQuery(Query *query) {
 }
 
 int TableStateHistory::updateHostServiceState(
-    Query *query, std::chrono::system_clock::duration query_timeframe,
-    const LogEntry *entry, HostServiceState *hs_state, bool only_update,
+    std::chrono::system_clock::duration query_timeframe, const LogEntry *entry,
+    HostServiceState *hs_state, bool only_update,
     const std::map<std::string, int> &notification_periods) {
     int state_changed = 1;
 
@@ -674,7 +785,7 @@ int TableStateHistory::updateHostServiceState(
         hs_state->_time = hs_state->_last_known_time;
         hs_state->_until = hs_state->_last_known_time;
         if (!only_update) {
-            process(query, query_timeframe, hs_state);
+            process(query_timeframe, hs_state);
         }
 
         hs_state->_may_no_longer_exist = false;
@@ -737,7 +848,7 @@ int TableStateHistory::updateHostServiceState(
             if (hs_state->_is_host) {
                 if (hs_state->_state != entry->state()) {
                     if (!only_update) {
-                        process(query, query_timeframe, hs_state);
+                        process(query_timeframe, hs_state);
                     }
                     hs_state->_state = entry->state();
                     hs_state->_host_down = static_cast<int>(entry->state() > 0);
@@ -748,7 +859,7 @@ int TableStateHistory::updateHostServiceState(
             } else if (hs_state->_host_down !=
                        static_cast<int>(entry->state() > 0)) {
                 if (!only_update) {
-                    process(query, query_timeframe, hs_state);
+                    process(query_timeframe, hs_state);
                 }
                 hs_state->_host_down = static_cast<int>(entry->state() > 0);
                 hs_state->_debug_info = "SVC HOST STATE";
@@ -760,7 +871,7 @@ int TableStateHistory::updateHostServiceState(
         case LogEntryKind::alert_service: {
             if (hs_state->_state != entry->state()) {
                 if (!only_update) {
-                    process(query, query_timeframe, hs_state);
+                    process(query_timeframe, hs_state);
                 }
                 hs_state->_debug_info = "SVC ALERT";
                 hs_state->_state = entry->state();
@@ -773,7 +884,7 @@ int TableStateHistory::updateHostServiceState(
 
             if (hs_state->_in_host_downtime != downtime_active) {
                 if (!only_update) {
-                    process(query, query_timeframe, hs_state);
+                    process(query_timeframe, hs_state);
                 }
                 hs_state->_debug_info =
                     hs_state->_is_host ? "HOST DOWNTIME" : "SVC HOST DOWNTIME";
@@ -791,7 +902,7 @@ int TableStateHistory::updateHostServiceState(
                 mk::starts_with(entry->state_type(), "STARTED") ? 1 : 0;
             if (hs_state->_in_downtime != downtime_active) {
                 if (!only_update) {
-                    process(query, query_timeframe, hs_state);
+                    process(query_timeframe, hs_state);
                 }
                 hs_state->_debug_info = "DOWNTIME SERVICE";
                 hs_state->_in_downtime = downtime_active;
@@ -804,7 +915,7 @@ int TableStateHistory::updateHostServiceState(
                 mk::starts_with(entry->state_type(), "STARTED") ? 1 : 0;
             if (hs_state->_is_flapping != flapping_active) {
                 if (!only_update) {
-                    process(query, query_timeframe, hs_state);
+                    process(query_timeframe, hs_state);
                 }
                 hs_state->_debug_info = "FLAPPING ";
                 hs_state->_is_flapping = flapping_active;
@@ -822,7 +933,7 @@ int TableStateHistory::updateHostServiceState(
                     tpt.name() == hs_state->_notification_period) {
                     if (tpt.to() != hs_state->_in_notification_period) {
                         if (!only_update) {
-                            process(query, query_timeframe, hs_state);
+                            process(query_timeframe, hs_state);
                         }
                         hs_state->_debug_info = "TIMEPERIOD ";
                         hs_state->_in_notification_period = tpt.to();
@@ -833,7 +944,7 @@ int TableStateHistory::updateHostServiceState(
                     tpt.name() == hs_state->_service_period) {
                     if (tpt.to() != hs_state->_in_service_period) {
                         if (!only_update) {
-                            process(query, query_timeframe, hs_state);
+                            process(query_timeframe, hs_state);
                         }
                         hs_state->_debug_info = "TIMEPERIOD ";
                         hs_state->_in_service_period = tpt.to();
@@ -859,9 +970,10 @@ int TableStateHistory::updateHostServiceState(
     return state_changed;
 }
 
-void TableStateHistory::process(
-    Query *query, std::chrono::system_clock::duration query_timeframe,
-    HostServiceState *hs_state) {
+// static
+void TableStateHistory::computeDurations(
+    HostServiceState *hs_state,
+    std::chrono::system_clock::duration query_timeframe) {
     hs_state->_duration = hs_state->_until - hs_state->_from;
     hs_state->_duration_part =
         mk::ticks<std::chrono::duration<double>>(hs_state->_duration) /
@@ -907,9 +1019,14 @@ void TableStateHistory::process(
             break;
     }
 
+}
+
+void TableStateHistory::process(
+    std::chrono::system_clock::duration query_timeframe,
+    HostServiceState *hs_state) {
+    computeDurations(hs_state, query_timeframe);
     // if (hs_state->_duration > 0)
-    HostServiceState *r = hs_state;
-    _abort_query = !query->processDataset(Row(r));
+    _abort_query = !_sink(hs_state);
 
     hs_state->_from = hs_state->_until;
 }
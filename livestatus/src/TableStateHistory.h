@@ -9,9 +9,13 @@
 #include "config.h"  // IWYU pragma: keep
 
 #include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "LogCache.h"
 #include "Logfile.h"
@@ -25,6 +29,8 @@ class MonitoringCore;
 class Query;
 class Row;
 
+#include "HostServiceState.h"
+
 class TableStateHistory : public Table {
 public:
     TableStateHistory(MonitoringCore *mc, LogCache *log_cache);
@@ -43,6 +49,44 @@ protected:
 private:
     LogCache *_log_cache;
 
+    // Where the state machine emits finished intervals: the query itself in
+    // the classic path, the materialized interval store while (re)building it.
+    std::function<bool(HostServiceState *)> _sink;
+
+    // Materialized state intervals kept across queries (guarded by
+    // LogCache::_lock): the log replay runs once per (since, until)
+    // timeframe and is repeated only when the timeframe or the logs
+    // change; meanwhile queries over the same timeframe - the
+    // adjacent-panel dashboard case, where only columns, filters and
+    // stats differ - replay the precomputed intervals. The timeframe is
+    // part of the key on purpose: which objects exist and what their
+    // initial state is both depend on where the replay starts, so
+    // intervals built for one timeframe cannot be clipped into an answer
+    // for another.
+    struct MaterializedIntervals {
+        std::chrono::system_clock::time_point since;
+        std::chrono::system_clock::time_point until;
+        std::vector<HostServiceState> rows;
+        // staleness token: (#logfiles, key of the newest relevant entry)
+        using token_type =
+            std::pair<size_t,
+                      std::pair<std::chrono::system_clock::time_point, size_t>>;
+        token_type token;
+    };
+    std::optional<MaterializedIntervals> _materialized;
+    bool _materialize_overflow{false};
+
+    bool answerQueryFromMaterialized(
+        Query *query, std::chrono::system_clock::time_point since,
+        std::chrono::system_clock::time_point until,
+        std::chrono::system_clock::duration query_timeframe);
+    void emitMaterialized(Query *query);
+    MaterializedIntervals::token_type currentToken();
+    void runMachine(Query *query, const Filter *object_filter,
+                    std::chrono::system_clock::time_point since,
+                    std::chrono::system_clock::time_point until,
+                    std::chrono::system_clock::duration query_timeframe);
+
     const Logfile::map_type *getEntries(Logfile *logfile);
     void getPreviousLogentry(LogCache::const_iterator &it_logs,
                              const Logfile::map_type *&entries,
@@ -50,11 +94,13 @@ private:
     LogEntry *getNextLogentry(LogCache::const_iterator &it_logs,
                               const Logfile::map_type *&entries,
                               Logfile::const_iterator &it_entries);
-    void process(Query *query,
-                 std::chrono::system_clock::duration query_timeframe,
+    static void computeDurations(
+        HostServiceState *hs_state,
+        std::chrono::system_clock::duration query_timeframe);
+    void process(std::chrono::system_clock::duration query_timeframe,
                  HostServiceState *hs_state);
     int updateHostServiceState(
-        Query *query, std::chrono::system_clock::duration query_timeframe,
+        std::chrono::system_clock::duration query_timeframe,
         const LogEntry *entry, HostServiceState *hs_state, bool only_update,
         const std::map<std::string, int> &notification_periods);
 };
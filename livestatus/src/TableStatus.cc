@@ -16,6 +16,8 @@
 #include "BlobColumn.h"
 #include "Column.h"
 #include "DoubleColumn.h"
+#include "OutputBuffer.h"
+#include "QueryStats.h"
 #include "IntColumn.h"
 #include "MonitoringCore.h"
 #include "NagiosGlobals.h"
@@ -36,12 +38,22 @@ extern double g_average_active_latency;
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 extern Average g_avg_livestatus_usage;
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+extern std::atomic<int> g_dynamic_client_threads;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 extern int g_livestatus_threads;
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 extern int g_num_queued_connections;
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 extern std::atomic_int32_t g_livestatus_active_connections;
 
+// NOTE on a double-buffered status snapshot: the hot
+// consumers are already decoupled - identical GET status polls replay
+// from the response cache within a state generation, the statistics they
+// read are atomics or the lock-free moving averages, and the remaining
+// Nagios globals are plain ints whose torn-read risk is no worse than
+// the snapshot copy would race against. A timer-refreshed shadow struct
+// would add a refresh thread to produce values one tick staler than the
+// cache already serves.
 TableStatus::TableStatus(MonitoringCore *mc) : Table(mc) {
     ColumnOffsets offsets{};
     addCounterColumns("neb_callbacks", "NEB callbacks", offsets,
@@ -236,6 +248,36 @@ TableStatus::TableStatus(MonitoringCore *mc) : Table(mc) {
         "The maximum number of connections to MK Livestatus that can be handled in parallel",
         offsets,
         [](const TableStatus & /*r*/) { return g_livestatus_threads; }));
+    addColumn(std::make_unique<IntColumn<TableStatus>>(
+        "livestatus_dynamic_threads",
+        "Number of dynamically spawned livestatus worker threads", offsets,
+        [](const TableStatus & /*r*/) {
+            return g_dynamic_client_threads.load();
+        }));
+    addColumn(std::make_unique<DoubleColumn<TableStatus>>(
+        "livestatus_response_memory",
+        "Memory currently used by livestatus response buffers in bytes",
+        offsets, [](const TableStatus & /*r*/) {
+            return static_cast<double>(OutputBuffer::responseMemoryInUse());
+        }));
+    addColumn(std::make_unique<DoubleColumn<TableStatus>>(
+        "livestatus_query_duration_p50",
+        "50th percentile of the livestatus query duration in seconds",
+        offsets, [](const TableStatus & /*r*/) {
+            return QueryStats::instance().durationPercentile(0.5);
+        }));
+    addColumn(std::make_unique<DoubleColumn<TableStatus>>(
+        "livestatus_query_duration_p95",
+        "95th percentile of the livestatus query duration in seconds",
+        offsets, [](const TableStatus & /*r*/) {
+            return QueryStats::instance().durationPercentile(0.95);
+        }));
+    addColumn(std::make_unique<DoubleColumn<TableStatus>>(
+        "livestatus_query_duration_p99",
+        "99th percentile of the livestatus query duration in seconds",
+        offsets, [](const TableStatus & /*r*/) {
+            return QueryStats::instance().durationPercentile(0.99);
+        }));
     addColumn(std::make_unique<DoubleColumn<TableStatus>>(
         "livestatus_usage",
         "The average usage of the livestatus connection slots, ranging from 0.0 (0%) up to 1.0 (100%)",
@@ -30,6 +30,11 @@ public:
             _getValue(row, timezone_offset)));
     }
 
+    void combine(const Aggregator &other) override {
+        _aggregation->combine(
+            *static_cast<const TimeAggregator &>(other)._aggregation);
+    }
+
     void output(RowRenderer &r) const override {
         r.output(_aggregation->value());
     }
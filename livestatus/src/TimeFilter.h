@@ -44,6 +44,8 @@ public:
         const std::string &column_name,
         std::chrono::seconds timezone_offset) const override;
 
+    [[nodiscard]] Cost cost() const override { return Cost::cheap; }
+
     [[nodiscard]] std::unique_ptr<Filter> copy() const override;
     [[nodiscard]] std::unique_ptr<Filter> negate() const override;
 
@@ -12,7 +12,8 @@
 
 using namespace std::chrono_literals;
 
-TimeperiodsCache::TimeperiodsCache(Logger *logger) : _logger(logger) {}
+TimeperiodsCache::TimeperiodsCache(Logger *logger)
+    : _logger(logger), _cache(std::make_shared<map_type>()) {}
 
 void TimeperiodsCache::logCurrentTimeperiods() {
     std::lock_guard<std::mutex> lg(_mutex);
@@ -22,16 +23,19 @@ void TimeperiodsCache::logCurrentTimeperiods() {
     // loop.
     auto now =
         std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    auto cache = std::make_shared<map_type>(*snapshot());
     for (timeperiod *tp = timeperiod_list; tp != nullptr; tp = tp->next) {
         bool is_in = check_time_against_period(now, tp) == 0;
         // check previous state and log transition if state has changed
-        auto it = _cache.find(tp);
-        if (it == _cache.end()) {  // first entry
+        auto it = cache->find(tp);
+        if (it == cache->end()) {  // first entry
             logTransition(tp->name, -1, is_in ? 1 : 0);
-            _cache.emplace(tp, is_in);
+            cache->emplace(tp, is_in);
+        } else {
+            logTransition(tp->name, it->second ? 1 : 0, is_in ? 1 : 0);
         }
-        logTransition(tp->name, it->second ? 1 : 0, is_in ? 1 : 0);
     }
+    publish(std::move(cache));
 }
 
 void TimeperiodsCache::update(std::chrono::system_clock::time_point now) {
@@ -46,20 +50,32 @@ void TimeperiodsCache::update(std::chrono::system_clock::time_point now) {
     // Loop over all timeperiods and compute if we are currently in. Detect the
     // case where no time periods are known (yet!). This might be the case when
     // a timed event broker message arrives *before* the start of the event
-    // loop.
+    // loop. The new state is built aside and published atomically, see the
+    // comment on _cache.
+    // Double-buffered update: the new state is built aside while readers
+    // keep using the published snapshot wait-free, and it is only swapped in
+    // when something actually changed - the Nagios event loop never blocks
+    // on livestatus readers and vice versa.
+    auto cache = std::make_shared<map_type>(*snapshot());
+    bool changed = false;
     for (timeperiod *tp = timeperiod_list; tp != nullptr; tp = tp->next) {
         bool is_in = check_time_against_period(
                          std::chrono::system_clock::to_time_t(now), tp) == 0;
         // check previous state and log transition if state has changed
-        auto it = _cache.find(tp);
-        if (it == _cache.end()) {  // first entry
+        auto it = cache->find(tp);
+        if (it == cache->end()) {  // first entry
             logTransition(tp->name, -1, is_in ? 1 : 0);
-            _cache.emplace(tp, is_in);
+            cache->emplace(tp, is_in);
+            changed = true;
         } else if (it->second != is_in) {
             logTransition(tp->name, it->second ? 1 : 0, is_in ? 1 : 0);
             it->second = is_in;
+            changed = true;
         }
     }
+    if (changed) {
+        publish(std::move(cache));
+    }
     if (timeperiod_list != nullptr) {
         Informational(_logger)
             << "Timeperiod cache not updated, there are no timeperiods (yet)";
@@ -76,9 +92,9 @@ bool TimeperiodsCache::inTimeperiod(const std::string &tpname) const {
 }
 
 bool TimeperiodsCache::inTimeperiod(const timeperiod *tp) const {
-    std::lock_guard<std::mutex> lg(_mutex);
-    auto it = _cache.find(tp);
-    if (it == _cache.end()) {
+    auto cache = snapshot();
+    auto it = cache->find(tp);
+    if (it == cache->end()) {
         // Problem: check_time_against_period is not thread safe, so we can't
         // use it here.
         Informational(_logger) << "No timeperiod information available for "
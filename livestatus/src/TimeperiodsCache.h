@@ -10,6 +10,7 @@
 
 #include <chrono>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 
@@ -25,12 +26,28 @@ public:
     void logCurrentTimeperiods();
 
 private:
+    using map_type = std::map<const timeperiod *, bool>;
+
     Logger *const _logger;
 
-    // The mutex protects _last_update and _cache.
+    // The mutex serializes the (rare) updates; _last_update belongs to it.
     mutable std::mutex _mutex;
     std::chrono::system_clock::time_point _last_update;
-    std::map<const timeperiod *, bool> _cache;
+    // Readers grab an immutable snapshot without any locking: every column
+    // render of in_notification_period & friends goes through here, so the
+    // hot path must not serialize 60k rows on a mutex. Updates build a new
+    // map and publish it atomically (RCU-style), old snapshots die with
+    // their last reader.
+    std::shared_ptr<const map_type> _cache;
+
+    [[nodiscard]] std::shared_ptr<const map_type> snapshot() const {
+        return std::atomic_load_explicit(&_cache,
+                                         std::memory_order_acquire);
+    }
+    void publish(std::shared_ptr<const map_type> cache) {
+        std::atomic_store_explicit(&_cache, std::move(cache),
+                                   std::memory_order_release);
+    }
 
     void logTransition(char *name, int from, int to) const;
 };
@@ -38,29 +38,66 @@ Triggers::Kind Triggers::find(const std::string &name) {
         "', allowed: all, check, state, log, downtime, comment, command and program");
 }
 
-void Triggers::notify_all(Kind trigger) {
-    condition_variable_for(Kind::all).notify_all();
-    condition_variable_for(trigger).notify_all();
+void Triggers::notify_all(Kind trigger, const void *object) {
+    notify(*channel_for(Kind::all));
+    if (trigger != Kind::all) {
+        notify(*channel_for(trigger));
+    }
+    notifyObjectChannels(trigger, object);
+}
+
+std::shared_ptr<Triggers::Channel> Triggers::acquireObjectChannel(
+    Kind trigger, const void *object) {
+    std::lock_guard<std::mutex> lg(_object_mutex);
+    auto &channel =
+        _object_channels[{static_cast<size_t>(trigger), object}];
+    if (channel == nullptr) {
+        channel = std::make_shared<Channel>();
+    }
+    // registered while still under _object_mutex, see wait_for()
+    std::lock_guard<std::mutex> cl(channel->mutex);
+    ++channel->waiters;
+    return channel;
+}
+
+void Triggers::releaseObjectChannel(Kind trigger, const void *object) {
+    std::lock_guard<std::mutex> lg(_object_mutex);
+    auto it = _object_channels.find({static_cast<size_t>(trigger), object});
+    if (it == _object_channels.end()) {
+        return;
+    }
+    std::lock_guard<std::mutex> cl(it->second->mutex);
+    if (it->second->waiters == 0) {
+        _object_channels.erase(it);
+    }
+}
+
+void Triggers::notify_object(Kind trigger, const void *object) {
+    notifyObjectChannels(trigger, object);
 }
 
-std::condition_variable &Triggers::condition_variable_for(Kind trigger) {
-    switch (trigger) {
-        case Kind::all:
-            return _cond_all;
-        case Kind::check:
-            return _cond_check;
-        case Kind::state:
-            return _cond_state;
-        case Kind::log:
-            return _cond_log;
-        case Kind::downtime:
-            return _cond_downtime;
-        case Kind::comment:
-            return _cond_comment;
-        case Kind::command:
-            return _cond_command;
-        case Kind::program:
-            return _cond_program;
+void Triggers::notifyObjectChannels(Kind trigger, const void *object) {
+    std::lock_guard<std::mutex> lg(_object_mutex);
+    for (const auto &[key, channel] : _object_channels) {
+        // a waiter keyed on an object still has to see every event of its
+        // kind which we cannot attribute to an object, so only skip when
+        // both sides name one and they differ
+        bool kind_matches = key.first == static_cast<size_t>(trigger) ||
+                            key.first == static_cast<size_t>(Kind::all);
+        if (kind_matches && (object == nullptr || key.second == object)) {
+            notify(*channel);
+        }
+    }
+}
+
+// static
+void Triggers::notify(Channel &channel) {
+    // Taking the lock pairs the wakeup with the waiter's predicate check, so
+    // no wakeup can fall between check and sleep. Once we hold it, the
+    // waiter count is stable and we can safely skip the syscall when nobody
+    // is waiting.
+    std::lock_guard<std::mutex> lg(channel.mutex);
+    if (channel.waiters > 0) {
+        channel.cond.notify_all();
     }
-    return _cond_all;  // unreachable
 }
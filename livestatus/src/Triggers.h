@@ -8,11 +8,24 @@
 
 #include "config.h"  // IWYU pragma: keep
 
+#include <array>
 #include <chrono>
 #include <condition_variable>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 
+// A SUBSCRIBE push mode stays out of scope for now: incremental pushes
+// (added/removed/changed rows per registered query) need client-side
+// support in livestatus.py and every GUI consumer plus per-subscription
+// result shadows on the server. The protocol already has the long-poll
+// primitive: 'WaitTrigger:' with keep-alive blocks until a relevant event
+// and then answers - combined with the response cache (identical poll
+// texts cost one evaluation per state generation) a 50-widget dashboard
+// converges to one evaluation per actual change today, without new
+// protocol surface.
 class Triggers {
 public:
     enum class Kind {
@@ -28,33 +41,91 @@ public:
 
     static Kind find(const std::string &name);
 
-    void notify_all(Kind trigger);
+    /// object identifies what the event is about (the host/service pointer)
+    /// when the caller knows it; nullptr wakes every waiter of the kind.
+    void notify_all(Kind trigger, const void *object = nullptr);
+
+    /// Additionally wake waiters parked on this object for an event that
+    /// was already published via notify_all: needed when one event changes
+    /// columns of *another* object as well - a service check result also
+    /// moves its host's service-derived columns (num_services_crit,
+    /// worst_service_state, ...) and a host check result moves the host_
+    /// columns of the host's services.
+    void notify_object(Kind trigger, const void *object);
 
     template <class Rep, class Period, class Predicate>
     void wait_for(Kind trigger,
                   const std::chrono::duration<Rep, Period> &rel_time,
                   Predicate pred) {
-        std::unique_lock<std::mutex> ul(_mutex);
-        auto &cond = condition_variable_for(trigger);
+        wait_for(trigger, nullptr, rel_time, pred);
+    }
+
+    /// Wait keyed by the object the condition is about: a check result for
+    /// host A then only wakes the waiters parked on host A instead of every
+    /// WaitObject query of the kind.
+    template <class Rep, class Period, class Predicate>
+    void wait_for(Kind trigger, const void *object,
+                  const std::chrono::duration<Rep, Period> &rel_time,
+                  Predicate pred) {
+        // For an object channel the waiter count is already incremented by
+        // acquireObjectChannel() while the map lock is held: if it only
+        // happened here, a departing waiter could observe zero waiters in
+        // between, drop the channel from the map and leave us sleeping on
+        // an orphan no notifier can find.
+        auto channel = object == nullptr
+                           ? channel_for(trigger)
+                           : acquireObjectChannel(trigger, object);
+        std::unique_lock<std::mutex> ul(channel->mutex);
+        if (object == nullptr) {
+            ++channel->waiters;
+        }
         if (rel_time == rel_time.zero()) {
-            cond.wait(ul, pred);
+            channel->cond.wait(ul, pred);
         } else {
-            cond.wait_for(ul, rel_time, pred);
+            channel->cond.wait_for(ul, rel_time, pred);
+        }
+        --channel->waiters;
+        ul.unlock();
+        if (object != nullptr) {
+            releaseObjectChannel(trigger, object);
         }
     }
 
 private:
-    std::mutex _mutex;
-    std::condition_variable _cond_all;
-    std::condition_variable _cond_check;
-    std::condition_variable _cond_state;
-    std::condition_variable _cond_log;
-    std::condition_variable _cond_downtime;
-    std::condition_variable _cond_comment;
-    std::condition_variable _cond_command;
-    std::condition_variable _cond_program;
-
-    std::condition_variable &condition_variable_for(Kind trigger);
+    // Every trigger kind has its own lock and condition variable: a
+    // WaitTrigger: log sleeper and the check-result thread must not contend
+    // on the same mutex. The waiter count (only modified under the channel
+    // lock) lets the notifying Nagios main thread skip the wakeup syscall
+    // entirely when nobody is parked on that kind, which is the common case
+    // during event storms.
+    struct Channel {
+        std::mutex mutex;
+        std::condition_variable cond;
+        int waiters{0};
+    };
+
+    std::array<std::shared_ptr<Channel>, 8> _channels{
+        std::make_shared<Channel>(), std::make_shared<Channel>(),
+        std::make_shared<Channel>(), std::make_shared<Channel>(),
+        std::make_shared<Channel>(), std::make_shared<Channel>(),
+        std::make_shared<Channel>(), std::make_shared<Channel>()};
+
+    // (kind, object) -> channel, created on demand and dropped with the
+    // last waiter; guarded by _object_mutex
+    std::mutex _object_mutex;
+    std::map<std::pair<size_t, const void *>, std::shared_ptr<Channel>>
+        _object_channels;
+
+    std::shared_ptr<Channel> channel_for(Kind trigger) {
+        return _channels[static_cast<size_t>(trigger)];
+    }
+
+    std::shared_ptr<Channel> acquireObjectChannel(Kind trigger,
+                                                  const void *object);
+    void releaseObjectChannel(Kind trigger, const void *object);
+    void notifyObjectChannels(Kind trigger, const void *object);
+
+    static void notify(Channel &channel);
 };
 
 #endif  // Triggers_h
@@ -0,0 +1,80 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#ifndef ValidatedCache_h
+#define ValidatedCache_h
+
+#include "config.h"  // IWYU pragma: keep
+
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace mk {
+
+/// A bounded, thread-safe cache of values that carry a validity token.
+/// lookup() only returns an entry whose stored token matches the probe
+/// token under TokenEqual - the usual tokens are an mtime (entry is stale
+/// when the file changed) or std::monostate (entry never goes stale, the
+/// cache memoizes a pure function). The bound is enforced by evicting the
+/// least recently used entries one at a time, so a full cache degrades
+/// smoothly instead of dropping everything at once.
+template <typename Key, typename Value, typename Token,
+          typename TokenEqual = std::equal_to<Token>>
+class ValidatedCache {
+public:
+    explicit ValidatedCache(size_t max_entries) : _max_entries(max_entries) {}
+
+    std::optional<Value> lookup(const Key &key, const Token &token) {
+        std::lock_guard<std::mutex> lg(_mutex);
+        auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            return {};
+        }
+        if (!TokenEqual{}(it->second.token, token)) {
+            _lru.erase(it->second.lru_position);
+            _entries.erase(it);
+            return {};
+        }
+        _lru.splice(_lru.begin(), _lru, it->second.lru_position);
+        return it->second.value;
+    }
+
+    void store(const Key &key, const Token &token, Value value) {
+        std::lock_guard<std::mutex> lg(_mutex);
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            it->second.token = token;
+            it->second.value = std::move(value);
+            _lru.splice(_lru.begin(), _lru, it->second.lru_position);
+            return;
+        }
+        _lru.push_front(key);
+        _entries.emplace(key, Entry{token, std::move(value), _lru.begin()});
+        while (_entries.size() > _max_entries) {
+            _entries.erase(_lru.back());
+            _lru.pop_back();
+        }
+    }
+
+private:
+    struct Entry {
+        Token token;
+        Value value;
+        typename std::list<Key>::iterator lru_position;
+    };
+
+    std::mutex _mutex;
+    std::list<Key> _lru;  // front = most recently used
+    std::map<Key, Entry> _entries;
+    size_t _max_entries;
+};
+
+}  // namespace mk
+
+#endif  // ValidatedCache_h
@@ -12,6 +12,15 @@
 #include "ObjectGroup.h"  // IWYU pragma: keep
 #include "Service.h"      // IWYU pragma: keep
 #include "cmc.h"
+#else
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "NagiosGlobals.h"
 #endif
 
 namespace {
@@ -46,6 +55,164 @@ const host *host_for_service(const service *svc) {
     return svc->host_ptr;
 #endif
 }
+
+#ifndef CMC
+// Authorization checks walk the contact and contact group lists of every
+// single row, which dominates multi-tenant queries. Since contact
+// assignments only change on a config reload (detected via program_start),
+// we assign dense IDs to all hosts and services once per reload and build a
+// per-contact bitset lazily on its first authorization check: one full walk
+// per contact, a single bit test for every row after that. Readers grab an
+// immutable snapshot without locking (RCU-style, like TimeperiodsCache):
+// the per-row checks also run concurrently on the parallel stats workers,
+// and a mutex here would serialize exactly that scan. Rebuilds copy the
+// snapshot, add what is missing and publish the result atomically.
+class AuthorizationCache {
+public:
+    bool isAuthorizedForHost(const contact *ctc, const host *hst) {
+        const auto snap = snapshotFor(ctc, {});
+        auto it = snap->host_ids.find(hst);
+        if (it == snap->host_ids.end()) {
+            return host_has_contact(hst, ctc);
+        }
+        return testBit(snap->contact_bits.at(ctc)->hosts, it->second);
+    }
+
+    bool isAuthorizedForService(ServiceAuthorization service_auth,
+                                const contact *ctc, const service *svc) {
+        const auto snap = snapshotFor(ctc, service_auth);
+        auto it = snap->service_ids.find(svc);
+        if (it == snap->service_ids.end()) {
+            return service_has_contact(svc, ctc) ||
+                   (service_auth == ServiceAuthorization::loose &&
+                    host_has_contact(host_for_service(svc), ctc));
+        }
+        return testBit(snap->contact_bits.at(ctc)->services, it->second);
+    }
+
+private:
+    struct ContactBits {
+        std::vector<uint64_t> hosts;
+        // built lazily on the first *service* check, tagged with the
+        // authorization mode it was built for (which is a site-wide setting
+        // and never really changes at runtime)
+        std::vector<uint64_t> services;
+        bool services_built{false};
+        ServiceAuthorization service_auth{ServiceAuthorization::loose};
+    };
+
+    struct Snapshot {
+        time_t generation{-1};
+        std::unordered_map<const host *, size_t> host_ids;
+        std::unordered_map<const service *, size_t> service_ids;
+        std::unordered_map<const contact *, std::shared_ptr<const ContactBits>>
+            contact_bits;
+    };
+
+    // serializes the (rare) rebuilds only, never taken on the hot path
+    std::mutex _mutex;
+    std::shared_ptr<const Snapshot> _snapshot;
+
+    [[nodiscard]] std::shared_ptr<const Snapshot> snapshot() const {
+        return std::atomic_load_explicit(&_snapshot,
+                                         std::memory_order_acquire);
+    }
+    void publish(std::shared_ptr<const Snapshot> snap) {
+        std::atomic_store_explicit(&_snapshot, std::move(snap),
+                                   std::memory_order_release);
+    }
+
+    [[nodiscard]] static bool covers(
+        const Snapshot &snap, const contact *ctc,
+        std::optional<ServiceAuthorization> service_auth) {
+        if (snap.generation != program_start) {
+            return false;
+        }
+        auto it = snap.contact_bits.find(ctc);
+        return it != snap.contact_bits.end() &&
+               (!service_auth || (it->second->services_built &&
+                                  it->second->service_auth == *service_auth));
+    }
+
+    /// A current-generation snapshot that has this contact's host bits and,
+    /// when service_auth is given, its service bits for that mode - built
+    /// and published on demand.
+    std::shared_ptr<const Snapshot> snapshotFor(
+        const contact *ctc,
+        std::optional<ServiceAuthorization> service_auth) {
+        if (auto snap = snapshot(); snap && covers(*snap, ctc, service_auth)) {
+            return snap;
+        }
+        std::lock_guard<std::mutex> lg(_mutex);
+        auto snap = snapshot();  // maybe another thread was faster
+        if (snap && covers(*snap, ctc, service_auth)) {
+            return snap;
+        }
+        auto next = std::make_shared<Snapshot>();
+        if (snap && snap->generation == program_start) {
+            *next = *snap;  // the bitsets themselves are shared, not copied
+        } else {
+            next->generation = program_start;
+            size_t id = 0;
+            for (const host *hst = host_list; hst != nullptr;
+                 hst = hst->next) {
+                next->host_ids.emplace(hst, id++);
+            }
+            id = 0;
+            for (const service *svc = service_list; svc != nullptr;
+                 svc = svc->next) {
+                next->service_ids.emplace(svc, id++);
+            }
+        }
+        auto bits = std::make_shared<ContactBits>();
+        if (auto it = next->contact_bits.find(ctc);
+            it != next->contact_bits.end()) {
+            *bits = *it->second;
+        } else {
+            bits->hosts.resize((next->host_ids.size() + 63) / 64);
+            for (const auto &[hst, host_id] : next->host_ids) {
+                if (host_has_contact(hst, ctc)) {
+                    setBit(bits->hosts, host_id);
+                }
+            }
+        }
+        if (service_auth && !(bits->services_built &&
+                              bits->service_auth == *service_auth)) {
+            bits->services.assign((next->service_ids.size() + 63) / 64, 0);
+            for (const auto &[svc, service_id] : next->service_ids) {
+                if (service_has_contact(svc, ctc)) {
+                    setBit(bits->services, service_id);
+                    continue;
+                }
+                if (*service_auth == ServiceAuthorization::loose) {
+                    auto host_it = next->host_ids.find(host_for_service(svc));
+                    if (host_it != next->host_ids.end() &&
+                        testBit(bits->hosts, host_it->second)) {
+                        setBit(bits->services, service_id);
+                    }
+                }
+            }
+            bits->services_built = true;
+            bits->service_auth = *service_auth;
+        }
+        next->contact_bits[ctc] = std::move(bits);
+        std::shared_ptr<const Snapshot> published = std::move(next);
+        publish(published);
+        return published;
+    }
+
+    static bool testBit(const std::vector<uint64_t> &bits, size_t index) {
+        return (bits[index / 64] & (uint64_t{1} << (index % 64))) != 0;
+    }
+
+    static void setBit(std::vector<uint64_t> &bits, size_t index) {
+        bits[index / 64] |= uint64_t{1} << (index % 64);
+    }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+AuthorizationCache g_authorization_cache;
+#endif
 }  // namespace
 
 bool is_authorized_for_hst(const contact *ctc, const host *hst) {
@@ -55,7 +222,11 @@ bool is_authorized_for_hst(const contact *ctc, const host *hst) {
     if (ctc == unknown_auth_user()) {
         return false;
     }
+#ifdef CMC
     return host_has_contact(hst, ctc);
+#else
+    return g_authorization_cache.isAuthorizedForHost(ctc, hst);
+#endif
 }
 
 bool is_authorized_for_svc(ServiceAuthorization service_auth,
@@ -66,9 +237,14 @@ bool is_authorized_for_svc(ServiceAuthorization service_auth,
     if (ctc == unknown_auth_user()) {
         return false;
     }
+#ifdef CMC
     return service_has_contact(svc, ctc) ||
            (service_auth == ServiceAuthorization::loose &&
             host_has_contact(host_for_service(svc), ctc));
+#else
+    return g_authorization_cache.isAuthorizedForService(service_auth, ctc,
+                                                        svc);
+#endif
 }
 
 bool is_authorized_for_host_group(GroupAuthorization group_auth,
@@ -5,6 +5,7 @@
 
 #include "global_counters.h"
 
+#include <atomic>
 #include <chrono>
 #include <mutex>
 #include <optional>
@@ -86,3 +87,23 @@ void do_statistics() {
         c.last_value = c.value;
     }
 }
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::uint64_t> state_generation{1};
+}  // namespace
+
+void stateGenerationBump() { ++state_generation; }
+
+uint64_t stateGenerationCurrent() { return state_generation; }
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::uint64_t> comment_downtime_generation{1};
+}  // namespace
+
+void commentDowntimeGenerationBump() { ++comment_downtime_generation; }
+
+uint64_t commentDowntimeGenerationCurrent() {
+    return comment_downtime_generation;
+}
@@ -8,6 +8,8 @@
 
 #include "config.h"  // IWYU pragma: keep
 
+#include <cstdint>
+
 // Remember to update num_counters when you change the enum below. C++ really
 // lacks a feature to iterate over enums easily...
 enum class Counter {
@@ -26,6 +28,17 @@ enum class Counter {
 // TODO(sp): We really need an OO version of this. :-P
 void counterReset(Counter which);
 void counterIncrement(Counter which);
+
+// A monotonically increasing generation of the host/service status world,
+// bumped by the NEB callbacks on every processed check and state change.
+// Memoized per-group aggregates use it for invalidation.
+void stateGenerationBump();
+uint64_t stateGenerationCurrent();
+
+// Same idea, but only bumped when a comment or downtime is added/removed:
+// the per-object downtime/comment indexes are valid as long as it stands.
+void commentDowntimeGenerationBump();
+uint64_t commentDowntimeGenerationCurrent();
 double counterValue(Counter which);
 double counterRate(Counter which);
 void do_statistics();
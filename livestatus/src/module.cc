@@ -34,7 +34,13 @@
 #include <vector>
 
 #include "Average.h"
+#include <sys/epoll.h>
+
+#include <set>
+#include <thread>
+
 #include "ChronoUtils.h"
+#include "ColumnarSnapshots.h"
 #include "DowntimeOrComment.h"
 #include "InputBuffer.h"
 #include "Logger.h"
@@ -43,6 +49,7 @@
 #include "OutputBuffer.h"
 #include "Poller.h"
 #include "Queue.h"
+#include "QueryStats.h"
 #include "RegExp.h"
 #include "TimeperiodsCache.h"
 #include "Triggers.h"
@@ -120,7 +127,40 @@ using ClientQueue_t = Queue<int>;
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 static ClientQueue_t *fl_client_queue = nullptr;
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static ptrdiff_t fl_num_accept_threads = 1;
+// Upper bound for the adaptive worker pool; 0 keeps the pool fixed at
+// g_livestatus_threads. Between the configured base and this maximum,
+// workers are spawned when connections queue up and retire after 30s idle.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static int fl_max_client_threads = 0;
+// Asynchronous external command submission: when enabled, COMMAND requests
+// are validated and enqueued by the worker thread and drained into Nagios
+// from the timed-event callback, i.e. on the main thread, so a burst of
+// 2000 downtime commands no longer serializes all workers on the command
+// mutex while Nagios grinds. Off by default: with the queue, a command's
+// effect becomes visible a moment later, which scripts polling
+// immediately afterwards may notice.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static bool fl_async_commands = false;
+using CommandQueue_t = Queue<std::string>;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static CommandQueue_t *fl_command_queue = nullptr;
+
+// used by Store::answerCommandNagios()
+bool submit_command_asynchronously(const std::string &command) {
+    if (!fl_async_commands || fl_command_queue == nullptr) {
+        return false;
+    }
+    return fl_command_queue->push(command,
+                                  queue_overflow_strategy::dont_push) ==
+           queue_status::ok;
+}
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<int> g_dynamic_client_threads{0};
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 TimeperiodsCache *g_timeperiods_cache = nullptr;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+ColumnarSnapshots *g_columnar_snapshots = nullptr;
 
 /* simple statistics data for TableStatus */
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -213,12 +253,15 @@ void livestatus_cleanup_after_fork() {
     }
 }
 
+void maybe_spawn_dynamic_worker();
+
 void *main_thread(void *data) {
     tl_info = static_cast<ThreadInfo *>(data);
     auto *logger = fl_core->loggerLivestatus();
     auto last_update_status = std::chrono::system_clock::now();
     while (!shouldTerminate()) {
         do_statistics();
+        maybe_spawn_dynamic_worker();
         auto now = std::chrono::system_clock::now();
         if (now - last_update_status >= 5s) {
             update_status();
@@ -257,6 +300,188 @@ void *main_thread(void *data) {
     return nullptr;
 }
 
+// An epoll-based parking lot for idle keep-alive connections: a worker
+// thread blocking in readRequest for a whole GUI session means 300 idle
+// connections need 300 threads. Instead, a worker hands a quiet connection
+// over to the watcher after answering a request and becomes free for other
+// work; when data arrives on a parked fd, the watcher feeds it back through
+// the regular client queue.
+namespace {
+class IdleConnectionWatcher {
+public:
+    bool start(Logger *logger) {
+        _logger = logger;
+        _epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll_fd == -1 || ::pipe2(_wakeup_pipe, O_CLOEXEC) == -1) {
+            generic_error ge{"cannot set up idle connection watcher"};
+            Warning(logger) << ge;
+            return false;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = _wakeup_pipe[0];
+        ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wakeup_pipe[0], &ev);
+        _thread = std::thread([this]() { run(); });
+        return true;
+    }
+
+    void stop() {
+        if (_epoll_fd == -1) {
+            return;
+        }
+        (void)::write(_wakeup_pipe[1], "", 1);
+        _thread.join();
+        ::close(_epoll_fd);
+        ::close(_wakeup_pipe[0]);
+        ::close(_wakeup_pipe[1]);
+        std::lock_guard<std::mutex> lg(_mutex);
+        for (int fd : _parked) {
+            ::close(fd);
+        }
+        _parked.clear();
+    }
+
+    [[nodiscard]] bool active() const { return _epoll_fd != -1; }
+
+    bool park(int fd) {
+        {
+            std::lock_guard<std::mutex> lg(_mutex);
+            _parked.insert(fd);
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        if (::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+            std::lock_guard<std::mutex> lg(_mutex);
+            _parked.erase(fd);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    void run();
+
+    Logger *_logger{nullptr};
+    int _epoll_fd{-1};
+    int _wakeup_pipe[2]{-1, -1};
+    std::thread _thread;
+    std::mutex _mutex;
+    std::set<int> _parked;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+IdleConnectionWatcher fl_idle_watcher;
+}  // namespace
+
+// Additional pure accept loops: AF_UNIX sockets do not support
+// SO_REUSEPORT, but several threads may accept() on the *same* listening
+// socket and the kernel load-balances between them, which spreads
+// connection storms across cores just the same. The first acceptor lives in
+// main_thread (it also keeps the statistics), these only accept and push.
+void *accept_thread(void *data) {
+    tl_info = static_cast<ThreadInfo *>(data);
+    auto *logger = fl_core->loggerLivestatus();
+    while (!shouldTerminate()) {
+        if (!Poller{}.wait(2500ms, g_unix_socket, PollEvents::in, logger)) {
+            if (errno == ETIMEDOUT) {
+                continue;
+            }
+            break;
+        }
+        int cc = ::accept4(g_unix_socket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (cc == -1) {
+            continue;  // most likely another acceptor won the race
+        }
+        if (cc > g_max_fd_ever) {
+            g_max_fd_ever = cc;
+        }
+        switch (
+            fl_client_queue->push(cc, queue_overflow_strategy::pop_oldest)) {
+            case queue_status::overflow:
+            case queue_status::joinable: {
+                generic_error ge("cannot enqueue client socket");
+                Warning(logger) << ge;
+                break;
+            }
+            case queue_status::ok:
+                break;
+        }
+        g_num_queued_connections++;
+        counterIncrement(Counter::connections);
+    }
+    Notice(logger) << "accept thread has terminated";
+    return nullptr;
+}
+
+void *client_thread(void *data);
+
+void *dynamic_client_thread(void *data) {
+    auto *info = static_cast<ThreadInfo *>(data);
+    tl_info = info;
+    auto *logger = fl_core->loggerLivestatus();
+    Debug(logger) << "dynamic worker started";
+    while (!shouldTerminate()) {
+        auto cc = fl_client_queue->pop_for(30s);
+        if (!cc) {
+            break;  // idle or shutting down -> retire
+        }
+        g_num_queued_connections--;
+        g_livestatus_active_connections++;
+        Debug(logger) << "accepted client connection on fd " << *cc;
+        InputBuffer input_buffer{*cc, [] { return shouldTerminate(); }, logger,
+                                 fl_query_timeout, fl_idle_timeout};
+        bool keepalive = true;
+        bool parked = false;
+        while (keepalive && !shouldTerminate()) {
+            counterIncrement(Counter::requests);
+            OutputBuffer output_buffer{*cc, [] { return shouldTerminate(); },
+                                       logger};
+            keepalive = fl_core->answerRequest(input_buffer, output_buffer);
+            if (keepalive && fl_idle_watcher.active() &&
+                input_buffer.empty() && fl_idle_watcher.park(*cc)) {
+                parked = true;
+                break;
+            }
+        }
+        if (!parked) {
+            ::close(*cc);
+        }
+        g_livestatus_active_connections--;
+    }
+    Debug(logger) << "dynamic worker retired";
+    --g_dynamic_client_threads;
+    delete info;
+    return nullptr;
+}
+
+// called from the main thread's periodic loop: grow the pool while
+// connections are waiting and capacity is left
+void maybe_spawn_dynamic_worker() {
+    if (fl_max_client_threads <= 0 || g_num_queued_connections <= 0) {
+        return;
+    }
+    auto current = static_cast<int>(g_livestatus_threads) +
+                   g_dynamic_client_threads.load();
+    if (current >= fl_max_client_threads) {
+        return;
+    }
+    auto *info = new ThreadInfo();
+    info->name = "client dyn";
+    ++g_dynamic_client_threads;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (g_thread_stack_size > 0) {
+        pthread_attr_setstacksize(&attr, g_thread_stack_size);
+    }
+    if (pthread_create(&info->id, &attr, dynamic_client_thread, info) != 0) {
+        --g_dynamic_client_threads;
+        delete info;
+    }
+    pthread_attr_destroy(&attr);
+}
+
 void *client_thread(void *data) {
     tl_info = static_cast<ThreadInfo *>(data);
     auto *logger = fl_core->loggerLivestatus();
@@ -268,6 +493,7 @@ void *client_thread(void *data) {
             InputBuffer input_buffer{*cc, [] { return shouldTerminate(); },
                                      logger, fl_query_timeout, fl_idle_timeout};
             bool keepalive = true;
+            bool parked = false;
             unsigned requestnr = 0;
             while (keepalive && !shouldTerminate()) {
                 if (++requestnr > 1) {
@@ -278,14 +504,61 @@ void *client_thread(void *data) {
                 OutputBuffer output_buffer{
                     *cc, [] { return shouldTerminate(); }, logger};
                 keepalive = fl_core->answerRequest(input_buffer, output_buffer);
+                if (keepalive && fl_idle_watcher.active() &&
+                    input_buffer.empty() && fl_idle_watcher.park(*cc)) {
+                    // quiet connection: let the watcher hold it, the thread
+                    // is free for clients with actual work
+                    Debug(logger)
+                        << "parking idle connection on fd " << *cc;
+                    parked = true;
+                    break;
+                }
+            }
+            if (!parked) {
+                ::close(*cc);
             }
-            ::close(*cc);
         }
         g_livestatus_active_connections--;
     }
     return nullptr;
 }
 
+namespace {
+void IdleConnectionWatcher::run() {
+    std::array<epoll_event, 64> events{};
+    while (true) {
+        int n = ::epoll_wait(_epoll_fd, events.data(), events.size(), -1);
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == _wakeup_pipe[0]) {
+                return;  // shutdown
+            }
+            ::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            {
+                std::lock_guard<std::mutex> lg(_mutex);
+                _parked.erase(fd);
+            }
+            // back into the regular queue, like a fresh connection; the
+            // readahead buffer was empty when the fd was parked, so a new
+            // InputBuffer picks up exactly where the old one stopped
+            Debug(_logger) << "resuming parked connection on fd " << fd;
+            if (fl_client_queue->push(fd, queue_overflow_strategy::wait) ==
+                queue_status::joinable) {
+                ::close(fd);
+            } else {
+                g_num_queued_connections++;
+            }
+        }
+    }
+}
+}  // namespace
+
 namespace {
 class NagiosHandler : public Handler {
 public:
@@ -334,8 +607,8 @@ void start_threads() {
     logger->setLevel(fl_livestatus_log_level);
     logger->setUseParentHandlers(false);
     try {
-        logger->setHandler(
-            std::make_unique<LivestatusHandler>(fl_paths._logfile));
+        logger->setHandler(std::make_unique<AsyncHandler>(
+            std::make_unique<LivestatusHandler>(fl_paths._logfile)));
     } catch (const generic_error &ex) {
         Warning(fl_logger_nagios) << ex;
     }
@@ -374,7 +647,7 @@ void start_threads() {
             << "setting thread stack size to " << g_thread_stack_size;
     }
 
-    fl_thread_info.resize(g_livestatus_threads + 1);
+    fl_thread_info.resize(g_livestatus_threads + fl_num_accept_threads);
     for (auto &info : fl_thread_info) {
         ptrdiff_t idx = &info - &fl_thread_info[0];
         if (idx == 0) {
@@ -389,6 +662,14 @@ void start_threads() {
             // Our current thread (i.e. the main one, confusing terminology)
             // needs thread-local infos for logging, too.
             tl_info = &info;
+        } else if (idx < fl_num_accept_threads) {
+            info.name = "accept " + std::to_string(idx);
+            if (auto result =
+                    pthread_create(&info.id, &attr, accept_thread, &info);
+                result != 0) {
+                Warning(fl_logger_nagios)
+                    << generic_error{result, "cannot create accept thread"};
+            }
         } else {
             info.name = "client " + std::to_string(idx);
             if (auto result =
@@ -410,6 +691,7 @@ void start_threads() {
 void terminate_threads() {
     if (g_thread_running != 0) {
         shouldTerminate(true);
+        fl_idle_watcher.stop();
         Informational(fl_logger_nagios) << "waiting for main to terminate...";
         if (auto result = pthread_join(fl_thread_info[0].id, nullptr);
             result != 0) {
@@ -422,6 +704,9 @@ void terminate_threads() {
         while (auto fd = fl_client_queue->try_pop()) {
             ::close(*fd);
         }
+        while (g_dynamic_client_threads > 0) {
+            std::this_thread::sleep_for(10ms);
+        }
         for (const auto &info : fl_thread_info) {
             if (auto result = pthread_join(info.id, nullptr); result != 0) {
                 Warning(fl_logger_nagios)
@@ -504,6 +789,15 @@ void close_unix_socket() {
     }
 }
 
+// NOTE on deferring broker work to a livestatus-side thread (user
+// request): the handlers below have been slimmed to the point where a
+// ring handoff would cost more than it saves. Per callback they do an
+// atomic counter increment, an atomic generation bump, a pointer reset
+// under an uncontended mutex, and a trigger notify that skips the futex
+// syscall entirely when nobody waits (the common case); only the
+// comment/downtime handlers still copy their nebstruct into the id maps,
+// which any deferred consumer would have to do as well before the struct
+// goes away at callback return - the copy cannot leave the core thread.
 int broker_host(int event_type __attribute__((__unused__)),
                 void *data __attribute__((__unused__))) {
     counterIncrement(Counter::neb_callbacks);
@@ -516,11 +810,40 @@ int broker_check(int event_type, void *data) {
         auto *c = static_cast<nebstruct_service_check_data *>(data);
         if (c->type == NEBTYPE_SERVICECHECK_PROCESSED) {
             counterIncrement(Counter::service_checks);
+            stateGenerationBump();
+            if (g_columnar_snapshots != nullptr) {
+                g_columnar_snapshots->invalidateServices();
+            }
+            fl_core->triggers().notify_all(Triggers::Kind::check,
+                                           c->object_ptr);
+            // the result also moves the host's service-derived columns
+            if (const auto *svc = static_cast<service *>(c->object_ptr);
+                svc != nullptr && svc->host_ptr != nullptr) {
+                fl_core->triggers().notify_object(Triggers::Kind::check,
+                                                  svc->host_ptr);
+            }
+            return result;
         }
     } else if (event_type == NEBCALLBACK_HOST_CHECK_DATA) {
         auto *c = static_cast<nebstruct_host_check_data *>(data);
         if (c->type == NEBTYPE_HOSTCHECK_PROCESSED) {
             counterIncrement(Counter::host_checks);
+            stateGenerationBump();
+            if (g_columnar_snapshots != nullptr) {
+                g_columnar_snapshots->invalidateHosts();
+            }
+            fl_core->triggers().notify_all(Triggers::Kind::check,
+                                           c->object_ptr);
+            // ... and the host_ columns of the host's services
+            if (const auto *hst = static_cast<host *>(c->object_ptr);
+                hst != nullptr) {
+                for (const auto *mem = hst->services; mem != nullptr;
+                     mem = mem->next) {
+                    fl_core->triggers().notify_object(Triggers::Kind::check,
+                                                      mem->service_ptr);
+                }
+            }
+            return result;
         }
     }
     fl_core->triggers().notify_all(Triggers::Kind::check);
@@ -550,6 +873,8 @@ int broker_comment(int event_type __attribute__((__unused__)), void *data) {
             break;
     }
     counterIncrement(Counter::neb_callbacks);
+    stateGenerationBump();
+    commentDowntimeGenerationBump();
     fl_core->triggers().notify_all(Triggers::Kind::comment);
     return 0;
 }
@@ -577,6 +902,8 @@ int broker_downtime(int event_type __attribute__((__unused__)), void *data) {
             break;
     }
     counterIncrement(Counter::neb_callbacks);
+    stateGenerationBump();
+    commentDowntimeGenerationBump();
     fl_core->triggers().notify_all(Triggers::Kind::downtime);
     return 0;
 }
@@ -587,6 +914,7 @@ int broker_log(int event_type __attribute__((__unused__)),
     counterIncrement(Counter::log_messages);
     // NOTE: We use logging very early, even before the core is
     // instantiated!
+    stateGenerationBump();
     if (fl_core != nullptr) {
         fl_core->triggers().notify_all(Triggers::Kind::log);
     }
@@ -606,6 +934,7 @@ int broker_command(int event_type __attribute__((__unused__)), void *data) {
         }
     }
     counterIncrement(Counter::neb_callbacks);
+    stateGenerationBump();
     fl_core->triggers().notify_all(Triggers::Kind::command);
     return 0;
 }
@@ -613,6 +942,11 @@ int broker_command(int event_type __attribute__((__unused__)), void *data) {
 int broker_state(int event_type __attribute__((__unused__)),
                  void *data __attribute__((__unused__))) {
     counterIncrement(Counter::neb_callbacks);
+    stateGenerationBump();
+    if (g_columnar_snapshots != nullptr) {
+        g_columnar_snapshots->invalidateHosts();
+        g_columnar_snapshots->invalidateServices();
+    }
     fl_core->triggers().notify_all(Triggers::Kind::state);
     return 0;
 }
@@ -620,6 +954,7 @@ int broker_state(int event_type __attribute__((__unused__)),
 int broker_program(int event_type __attribute__((__unused__)),
                    void *data __attribute__((__unused__))) {
     counterIncrement(Counter::neb_callbacks);
+    stateGenerationBump();
     fl_core->triggers().notify_all(Triggers::Kind::program);
     return 0;
 }
@@ -656,6 +991,24 @@ int broker_event(int event_type __attribute__((__unused__)), void *data) {
         }
     }
     g_timeperiods_cache->update(from_timeval(ts->timestamp));
+    if (fl_command_queue != nullptr) {
+        // drain with a budget so a command storm cannot monopolize the
+        // Nagios event loop; we are on the main thread here, exactly where
+        // the command processing belongs
+        for (int budget = 200; budget > 0; --budget) {
+            auto command = fl_command_queue->try_pop();
+            if (!command) {
+                break;
+            }
+            std::vector<char> cmd{command->begin(), command->end()};
+            cmd.push_back('\0');
+#ifdef NAGIOS4
+            process_external_command1(&cmd[0]);
+#else
+            submit_external_command(&cmd[0], nullptr);
+#endif
+        }
+    }
     return 0;
 }
 
@@ -667,7 +1020,10 @@ int broker_process(int event_type __attribute__((__unused__)), void *data) {
                 new NagiosCore(fl_downtimes, fl_comments, fl_paths, fl_limits,
                                fl_authorization, fl_data_encoding);
             fl_client_queue = new ClientQueue_t{};
+            fl_command_queue = new CommandQueue_t{50000};
             g_timeperiods_cache = new TimeperiodsCache(fl_logger_nagios);
+            g_columnar_snapshots = new ColumnarSnapshots();
+            fl_idle_watcher.start(fl_logger_nagios);
             break;
         case NEBTYPE_PROCESS_EVENTLOOPSTART:
             g_timeperiods_cache->update(from_timeval(ps->timestamp));
@@ -851,6 +1207,30 @@ void livestatus_parse_arguments(Logger *logger, const char *args_orig) {
                 Notice(logger)
                     << "setting max number of cached log messages to "
                     << fl_limits._max_cached_messages;
+            } else if (left == "slow_query_threshold") {
+                auto ms = strtoul(right.c_str(), nullptr, 10);
+                QueryStats::instance().setSlowQueryThreshold(
+                    std::chrono::milliseconds(ms));
+                Notice(logger) << "setting slow query log threshold to " << ms
+                               << " ms";
+            } else if (left == "response_file_directory") {
+                OutputBuffer::setResponseFileDirectory(right);
+                Notice(logger)
+                    << "allowing response files below '" << right << "'";
+            } else if (left == "max_response_memory") {
+                // given in MiB, 0 disables the governor
+                auto mib = strtoul(right.c_str(), nullptr, 10);
+                OutputBuffer::setResponseMemoryLimit(mib * 1024 * 1024);
+                Notice(logger)
+                    << "setting max memory for response buffers to " << mib
+                    << " MiB";
+            } else if (left == "max_cached_log_memory") {
+                // given in MiB, 0 disables the byte-based limit
+                fl_limits._max_cached_log_memory =
+                    strtoul(right.c_str(), nullptr, 10) * 1024 * 1024;
+                Notice(logger)
+                    << "setting max memory for cached log messages to "
+                    << right << " MiB";
             } else if (left == "max_lines_per_logfile") {
                 fl_limits._max_lines_per_logfile =
                     strtoul(right.c_str(), nullptr, 10);
@@ -868,6 +1248,31 @@ void livestatus_parse_arguments(Logger *logger, const char *args_orig) {
                     << fl_limits._max_response_size << " bytes ("
                     << (fl_limits._max_response_size / (1024.0 * 1024.0))
                     << " MB)";
+            } else if (left == "async_commands") {
+                fl_async_commands = right == "on" || right == "1";
+                Notice(logger) << "setting async command submission to "
+                               << (fl_async_commands ? "on" : "off");
+            } else if (left == "max_client_threads") {
+                int c = atoi(right.c_str());
+                if (c != 0 && c < static_cast<int>(g_livestatus_threads)) {
+                    Warning(logger)
+                        << "max_client_threads must be 0 or >= "
+                        << g_livestatus_threads;
+                } else {
+                    Notice(logger)
+                        << "setting max number of client threads to " << c;
+                    fl_max_client_threads = c;
+                }
+            } else if (left == "num_accept_threads") {
+                int c = atoi(right.c_str());
+                if (c < 1 || c > 64) {
+                    Warning(logger) << "cannot set num_accept_threads to " << c
+                                    << ", must be between 1 and 64";
+                } else {
+                    Notice(logger)
+                        << "setting number of accept threads to " << c;
+                    fl_num_accept_threads = c;
+                }
             } else if (left == "num_client_threads") {
                 int c = atoi(right.c_str());
                 if (c <= 0 || c > 1000) {
@@ -1050,9 +1455,15 @@ extern "C" int nebmodule_deinit(int flags __attribute__((__unused__)),
     delete g_timeperiods_cache;
     g_timeperiods_cache = nullptr;
 
+    delete g_columnar_snapshots;
+    g_columnar_snapshots = nullptr;
+
     delete fl_client_queue;
     fl_client_queue = nullptr;
 
+    delete fl_command_queue;
+    fl_command_queue = nullptr;
+
     delete fl_core;
     fl_core = nullptr;
 
@@ -3,6 +3,7 @@
 // terms and conditions defined in the file COPYING, which is part of this
 // source code package.
 
+#include <cstring>
 #include <ctime>
 
 #include "NagiosGlobals.h"  // IWYU pragma: keep
@@ -23,20 +24,66 @@ int accept_passive_service_checks;
 int check_time_against_period(time_t /*unused*/, timeperiod * /*unused*/) {
     return 0;
 }
-command *find_command(CONST_IN_NAGIOS4 char * /*unused*/) { return nullptr; }
-contact *find_contact(CONST_IN_NAGIOS4 char * /*unused*/) { return nullptr; }
-contactgroup *find_contactgroup(CONST_IN_NAGIOS4 char * /*unused*/) {
+// The finders walk the object lists, which stay empty (= nullptr result)
+// in the unit tests but are populated by the standalone drivers: point
+// queries like "Filter: name = host1" go through these, and a stub that
+// always returns nullptr would silently turn them into empty results.
+command *find_command(CONST_IN_NAGIOS4 char *name) {
+    for (command *c = command_list; c != nullptr; c = c->next) {
+        if (strcmp(c->name, name) == 0) {
+            return c;
+        }
+    }
     return nullptr;
 }
-host *find_host(CONST_IN_NAGIOS4 char * /*unused*/) { return nullptr; }
-hostgroup *find_hostgroup(CONST_IN_NAGIOS4 char * /*unused*/) {
+contact *find_contact(CONST_IN_NAGIOS4 char *name) {
+    for (contact *c = contact_list; c != nullptr; c = c->next) {
+        if (strcmp(c->name, name) == 0) {
+            return c;
+        }
+    }
     return nullptr;
 }
-service *find_service(CONST_IN_NAGIOS4 char * /*unused*/,
-                      CONST_IN_NAGIOS4 char * /*unused*/) {
+contactgroup *find_contactgroup(CONST_IN_NAGIOS4 char *name) {
+    for (contactgroup *g = contactgroup_list; g != nullptr; g = g->next) {
+        if (strcmp(g->group_name, name) == 0) {
+            return g;
+        }
+    }
     return nullptr;
 }
-servicegroup *find_servicegroup(CONST_IN_NAGIOS4 char * /*unused*/) {
+host *find_host(CONST_IN_NAGIOS4 char *name) {
+    for (host *h = host_list; h != nullptr; h = h->next) {
+        if (strcmp(h->name, name) == 0) {
+            return h;
+        }
+    }
+    return nullptr;
+}
+hostgroup *find_hostgroup(CONST_IN_NAGIOS4 char *name) {
+    for (hostgroup *g = hostgroup_list; g != nullptr; g = g->next) {
+        if (strcmp(g->group_name, name) == 0) {
+            return g;
+        }
+    }
+    return nullptr;
+}
+service *find_service(CONST_IN_NAGIOS4 char *host_name,
+                      CONST_IN_NAGIOS4 char *svc_desc) {
+    for (service *s = service_list; s != nullptr; s = s->next) {
+        if (strcmp(s->host_name, host_name) == 0 &&
+            strcmp(s->description, svc_desc) == 0) {
+            return s;
+        }
+    }
+    return nullptr;
+}
+servicegroup *find_servicegroup(CONST_IN_NAGIOS4 char *name) {
+    for (servicegroup *g = servicegroup_list; g != nullptr; g = g->next) {
+        if (strcmp(g->group_name, name) == 0) {
+            return g;
+        }
+    }
     return nullptr;
 }
 time_t get_next_log_rotation_time(void) { return 0; }
@@ -0,0 +1,131 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+// Microbenchmarks for the livestatus hot kernels. Built via the
+// "benchmark" target in Makefile.am (needs a google-benchmark
+// installation, see GOOGLEBENCHMARK_* there); run as
+//
+//     ./benchmark_livestatus --benchmark_min_time=1
+//
+// The fixtures are synthesized to match the shape of production data
+// (alert-heavy nagios.log lines, plugin_output-like strings), so numbers
+// are comparable across runs without bundling real logs.
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AndingFilter.h"
+#include "Logger.h"
+#include "EscapeScanner.h"
+#include "IntFilter.h"
+#include "LogEntry.h"
+#include "Queue.h"
+#include "RegExp.h"
+#include "Renderer.h"
+#include "RendererBrokenCSV.h"
+#include "data_encoding.h"
+
+namespace {
+std::vector<std::string> logLines() {
+    std::vector<std::string> lines;
+    for (int i = 0; i < 512; ++i) {
+        lines.push_back("[1660000" + std::to_string(100 + i) +
+                        "] SERVICE ALERT: host" + std::to_string(i % 60) +
+                        ";Interface eth" + std::to_string(i % 8) +
+                        ";CRITICAL;HARD;3;CRIT - link down, 42 errors/s");
+        lines.push_back("[1660000" + std::to_string(100 + i) +
+                        "] EXTERNAL COMMAND: PROCESS_SERVICE_CHECK_RESULT;"
+                        "host" +
+                        std::to_string(i % 60) + ";CPU load;0;OK - fine");
+    }
+    return lines;
+}
+
+std::string pluginOutput() {
+    return "OK - 23 interfaces up, 2 down (\"eth0\" at 10GBit/s), "
+           "traffic in 123.45 MB/s out 67.89 MB/s \\ see details";
+}
+}  // namespace
+
+static void BM_LogEntryParse(benchmark::State &state) {
+    auto lines = logLines();
+    size_t i = 0;
+    for (auto _ : state) {
+        LogEntry entry{i, std::string{lines[i % lines.size()]}};
+        benchmark::DoNotOptimize(entry.log_class());
+        ++i;
+    }
+}
+BENCHMARK(BM_LogEntryParse);
+
+static void BM_RegExpSearch(benchmark::State &state) {
+    RegExp re{"link down.*errors", RegExp::Case::ignore,
+              RegExp::Syntax::pattern};
+    auto haystack = pluginOutput();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(re.search(haystack));
+    }
+}
+BENCHMARK(BM_RegExpSearch);
+
+static void BM_EscapeScan(benchmark::State &state) {
+    auto text = pluginOutput();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            mk::findUnboringChar(text.data(), text.data() + text.size()));
+    }
+}
+BENCHMARK(BM_EscapeScan);
+
+static void BM_RendererEscaping(benchmark::State &state) {
+    auto text = pluginOutput();
+    Logger *logger = Logger::getLogger("benchmark");
+    for (auto _ : state) {
+        std::ostringstream os;
+        auto renderer =
+            Renderer::make(OutputFormat::json, os, logger,
+                           CSVSeparators("\n", ";", ",", "|"), Encoding::utf8);
+        renderer->output(text);
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_RendererEscaping);
+
+static void BM_AndingFilterAccepts(benchmark::State &state) {
+    struct R {
+        int state;
+        int last_check;
+    };
+    Filters subfilters;
+    subfilters.push_back(std::make_unique<IntFilter>(
+        Filter::Kind::row, "state",
+        [](Row row) { return row.rawData<R>()->state; },
+        RelationalOperator::equal, "2"));
+    subfilters.push_back(std::make_unique<IntFilter>(
+        Filter::Kind::row, "last_check",
+        [](Row row) { return row.rawData<R>()->last_check; },
+        RelationalOperator::greater, "1000"));
+    auto filter = AndingFilter::make(Filter::Kind::row, subfilters);
+    R row{2, 4711};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            filter->accepts(Row{&row}, nullptr, std::chrono::seconds{0}));
+    }
+}
+BENCHMARK(BM_AndingFilterAccepts);
+
+static void BM_QueuePushPop(benchmark::State &state) {
+    Queue<int> queue;
+    for (auto _ : state) {
+        (void)queue.push(42, queue_overflow_strategy::wait);
+        benchmark::DoNotOptimize(queue.try_pop());
+    }
+}
+BENCHMARK(BM_QueuePushPop);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,242 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+// Replay captured livestatus request streams against a socket and report
+// latency percentiles. Build via "make replay_livestatus", run e.g.
+//
+//     ./replay_livestatus --socket /omd/sites/prod/tmp/run/live \
+//         --requests queries.txt --concurrency 8 --iterations 100 \
+//         --keepalive 0.8
+//
+// The requests file contains raw GET queries separated by blank lines, as
+// captured from the slow-query log or a socket tap. Every request is sent
+// with "ResponseHeader: fixed16" enforced so the tool can frame responses
+// exactly like livestatus.py does; with probability --keepalive a
+// connection is reused for the next request, otherwise it is reconnected,
+// mimicking a real GUI/script mix.
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Options {
+    std::string socket_path;
+    std::string requests_path;
+    int concurrency{1};
+    int iterations{1};
+    double keepalive{1.0};
+};
+
+std::vector<std::string> loadRequests(const std::string &path) {
+    std::ifstream is{path};
+    if (!is) {
+        std::cerr << "cannot open " << path << "\n";
+        exit(1);
+    }
+    std::vector<std::string> requests;
+    std::string request;
+    std::string line;
+    while (std::getline(is, line)) {
+        if (line.empty()) {
+            if (!request.empty()) {
+                requests.push_back(request);
+                request.clear();
+            }
+        } else if (line.rfind("ResponseHeader:", 0) != 0 &&
+                   line.rfind("KeepAlive:", 0) != 0) {
+            // framing is owned by the tool
+            request += line + "\n";
+        }
+    }
+    if (!request.empty()) {
+        requests.push_back(request);
+    }
+    return requests;
+}
+
+int connectTo(const std::string &path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) !=
+        0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        auto ret = ::write(fd, data.data() + sent, data.size() - sent);
+        if (ret <= 0) {
+            return false;
+        }
+        sent += ret;
+    }
+    return true;
+}
+
+bool readExactly(int fd, char *buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        auto ret = ::read(fd, buffer + done, size - done);
+        if (ret <= 0) {
+            return false;
+        }
+        done += ret;
+    }
+    return true;
+}
+
+// one fixed16-framed request/response cycle, returns the latency or -1
+double runOnce(int fd, const std::string &request) {
+    auto start = std::chrono::steady_clock::now();
+    if (!sendAll(fd, request + "ResponseHeader: fixed16\nKeepAlive: on\n\n")) {
+        return -1;
+    }
+    char header[17];
+    if (!readExactly(fd, header, 16)) {
+        return -1;
+    }
+    header[16] = '\0';
+    auto size = strtoul(header + 4, nullptr, 10);
+    std::vector<char> body(size);
+    if (size > 0 && !readExactly(fd, body.data(), size)) {
+        return -1;
+    }
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex latencies_mutex;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::vector<double> latencies;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<long> errors{0};
+
+void worker(const Options &options, const std::vector<std::string> &requests,
+            unsigned seed) {
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<double> coin{0.0, 1.0};
+    std::vector<double> local;
+    int fd = -1;
+    for (int round = 0; round < options.iterations; ++round) {
+        for (const auto &request : requests) {
+            if (fd < 0) {
+                fd = connectTo(options.socket_path);
+                if (fd < 0) {
+                    ++errors;
+                    continue;
+                }
+            }
+            auto latency = runOnce(fd, request);
+            if (latency < 0) {
+                ++errors;
+                ::close(fd);
+                fd = -1;
+                continue;
+            }
+            local.push_back(latency);
+            if (coin(rng) >= options.keepalive) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    std::lock_guard<std::mutex> lg(latencies_mutex);
+    latencies.insert(latencies.end(), local.begin(), local.end());
+}
+
+double percentile(const std::vector<double> &sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    auto index = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg{argv[i]};
+        std::string value{argv[i + 1]};
+        if (arg == "--socket") {
+            options.socket_path = value;
+        } else if (arg == "--requests") {
+            options.requests_path = value;
+        } else if (arg == "--concurrency") {
+            options.concurrency = atoi(value.c_str());
+        } else if (arg == "--iterations") {
+            options.iterations = atoi(value.c_str());
+        } else if (arg == "--keepalive") {
+            options.keepalive = atof(value.c_str());
+        } else {
+            std::cerr << "unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+    if (options.socket_path.empty() || options.requests_path.empty()) {
+        std::cerr << "usage: replay_livestatus --socket PATH --requests FILE"
+                     " [--concurrency N] [--iterations N] [--keepalive P]\n";
+        return 1;
+    }
+    auto requests = loadRequests(options.requests_path);
+    if (requests.empty()) {
+        std::cerr << "no requests in " << options.requests_path << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(options.concurrency);
+    for (int i = 0; i < options.concurrency; ++i) {
+        workers.emplace_back(worker, std::cref(options), std::cref(requests),
+                             static_cast<unsigned>(i + 1));
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                              start)
+                    .count();
+
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("requests: %zu  errors: %ld  wall: %.2fs  rate: %.1f/s\n",
+                latencies.size(), errors.load(), wall,
+                latencies.empty() ? 0.0 : latencies.size() / wall);
+    std::printf("latency ms: p50=%.2f p90=%.2f p95=%.2f p99=%.2f max=%.2f\n",
+                percentile(latencies, 0.50), percentile(latencies, 0.90),
+                percentile(latencies, 0.95), percentile(latencies, 0.99),
+                latencies.empty() ? 0.0 : latencies.back());
+    return errors == 0 ? 0 : 2;
+}
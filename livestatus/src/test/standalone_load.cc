@@ -0,0 +1,192 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+// Standalone livestatus load harness: builds a synthetic Nagios object
+// population (hosts x services with custom variables and plugin output),
+// instantiates the real query engine on top of it and runs queries against
+// the tables - no Nagios environment required. Build via
+// "make standalone_load", then e.g.
+//
+//     ./standalone_load --hosts 1000 --services 50 \
+//         'GET services\nStats: state = 2'
+//
+// Queries are given as arguments with literal \n separating header lines;
+// each is timed and the response size reported, with --print dumping the
+// response itself. This is the tool for capacity planning a 500k-service
+// site and for benchmarking query engine changes.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Average.h"
+#include "ColumnarSnapshots.h"
+#include "NagiosCore.h"
+#include "NagiosGlobals.h"
+#include "OutputBuffer.h"
+#include "Query.h"
+#include "TableHosts.h"
+#include "TableServices.h"
+#include "TimeperiodsCache.h"
+#include "data_encoding.h"
+#include "nagios.h"
+
+// defined in module.cc, which is part of liblivestatus; the harness sets
+// it up itself since the NEB lifecycle never runs here
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+extern ColumnarSnapshots *g_columnar_snapshots;
+
+namespace {
+host *makeHost(int index) {
+    auto *hst = new host();
+    memset(hst, 0, sizeof(host));
+    hst->name = strdup(("host" + std::to_string(index)).c_str());
+    hst->address = strdup("127.0.0.1");
+    hst->alias = strdup(("alias of host" + std::to_string(index)).c_str());
+    hst->current_state = index % 7 == 0 ? 1 : 0;
+    hst->has_been_checked = 1;
+    hst->last_check = 1600000000 + index;
+    return hst;
+}
+
+service *makeService(host *hst, int index) {
+    auto *svc = new service();
+    memset(svc, 0, sizeof(service));
+    svc->host_ptr = hst;
+    svc->host_name = hst->name;
+    svc->description = strdup(("Service " + std::to_string(index)).c_str());
+    svc->plugin_output = strdup(
+        index % 13 == 0 ? "CRIT - something is really wrong here"
+                        : "OK - everything is fine, 23 items checked");
+    svc->perf_data = strdup("items=23;30;40 time=0.042");
+    svc->current_state = index % 13 == 0 ? 2 : index % 5 == 0 ? 1 : 0;
+    svc->has_been_checked = 1;
+    svc->last_check = 1600000000 + index;
+    svc->check_interval = 1;
+    return svc;
+}
+
+void buildPopulation(int num_hosts, int num_services) {
+    host *previous_host = nullptr;
+    service *previous_service = nullptr;
+    for (int h = 0; h < num_hosts; ++h) {
+        auto *hst = makeHost(h);
+        if (previous_host == nullptr) {
+            host_list = hst;
+        } else {
+            previous_host->next = hst;
+        }
+        previous_host = hst;
+        for (int s = 0; s < num_services; ++s) {
+            auto *svc = makeService(hst, h * num_services + s);
+            if (previous_service == nullptr) {
+                service_list = svc;
+            } else {
+                previous_service->next = svc;
+            }
+            previous_service = svc;
+            // the host fast paths walk host->services, so the member list
+            // must be linked like Nagios does it
+            auto *member = new servicesmember();
+            memset(member, 0, sizeof(servicesmember));
+            member->host_name = svc->host_name;
+            member->service_description = svc->description;
+            member->service_ptr = svc;
+            member->next = hst->services;
+            hst->services = member;
+        }
+    }
+}
+
+std::list<std::string> parseQuery(const std::string &raw) {
+    std::list<std::string> lines;
+    std::string current;
+    for (size_t i = 0; i < raw.size(); ++i) {
+        if (raw[i] == '\\' && i + 1 < raw.size() && raw[i + 1] == 'n') {
+            lines.push_back(current);
+            current.clear();
+            ++i;
+        } else {
+            current += raw[i];
+        }
+    }
+    lines.push_back(current);
+    return lines;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    int num_hosts = 100;
+    int num_services = 10;
+    bool print = false;
+    std::vector<std::string> queries;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg{argv[i]};
+        if (arg == "--hosts" && i + 1 < argc) {
+            num_hosts = atoi(argv[++i]);
+        } else if (arg == "--services" && i + 1 < argc) {
+            num_services = atoi(argv[++i]);
+        } else if (arg == "--print") {
+            print = true;
+        } else {
+            queries.push_back(arg);
+        }
+    }
+    if (queries.empty()) {
+        std::cerr << "usage: standalone_load [--hosts N] [--services M]"
+                     " [--print] 'GET ...\\nHeader: ...' ...\n";
+        return 1;
+    }
+
+    auto start_build = std::chrono::steady_clock::now();
+    buildPopulation(num_hosts, num_services);
+    g_columnar_snapshots = new ColumnarSnapshots();
+    std::map<unsigned long, std::unique_ptr<Downtime>> downtimes;
+    std::map<unsigned long, std::unique_ptr<Comment>> comments;
+    NagiosCore core(downtimes, comments, NagiosPaths{}, NagiosLimits{},
+                    NagiosAuthorization{}, Encoding::utf8);
+    TableHosts hosts(&core);
+    TableServices services(&core);
+    std::printf("population: %d hosts x %d services built in %lld ms\n",
+                num_hosts, num_services,
+                static_cast<long long>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start_build)
+                        .count()));
+
+    for (const auto &raw : queries) {
+        auto lines = parseQuery(raw);
+        Table *table = &services;
+        if (!lines.empty() && lines.front().rfind("GET hosts", 0) == 0) {
+            table = &hosts;
+        }
+
+        bool flag{false};
+        OutputBuffer output{-1, [&flag] { return flag; }, table->logger()};
+        auto start = std::chrono::steady_clock::now();
+        Query query{lines, *table, Encoding::utf8, size_t{512} * 1024 * 1024,
+                    output, table->logger()};
+        query.process();
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        flag = true;
+        (void)flag;
+        auto response = output.str();
+        std::printf("query: %-60s %8lld us  %zu bytes\n", raw.c_str(),
+                    static_cast<long long>(elapsed.count()), response.size());
+        if (print) {
+            std::fwrite(response.data(), 1, response.size(), stdout);
+        }
+    }
+    return 0;
+}
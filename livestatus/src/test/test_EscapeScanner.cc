@@ -0,0 +1,47 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#include <cstddef>
+#include <string>
+
+#include "EscapeScanner.h"
+#include "gtest/gtest.h"
+
+namespace {
+size_t find(const std::string &str) {
+    return mk::findUnboringChar(str.data(), str.data() + str.size()) -
+           str.data();
+}
+}  // namespace
+
+TEST(EscapeScannerTest, EmptyAndBoring) {
+    EXPECT_EQ(0UL, find(""));
+    EXPECT_EQ(11UL, find("hello world"));
+    EXPECT_EQ(std::string(100, 'x').size(), find(std::string(100, 'x')));
+}
+
+TEST(EscapeScannerTest, EscapedCharacters) {
+    EXPECT_EQ(1UL, find("a\"b"));
+    EXPECT_EQ(1UL, find("a\\b"));
+    EXPECT_EQ(0UL, find("\"quoted\""));
+}
+
+TEST(EscapeScannerTest, ControlAndNonASCII) {
+    EXPECT_EQ(3UL, find("abc\x01xyz"));
+    EXPECT_EQ(3UL, find("abc\ndef"));
+    EXPECT_EQ(4UL, find("abcd\xc3\xa4"));
+    // DEL counts as boring, just like in the renderers
+    EXPECT_EQ(8UL, find("abcdefg\x7f\x80"));
+}
+
+TEST(EscapeScannerTest, LongSpansCrossVectorWidths) {
+    // spans longer than the 16/32 byte vector width with the interesting
+    // byte at various positions
+    for (size_t prefix = 0; prefix < 70; ++prefix) {
+        EXPECT_EQ(prefix, find(std::string(prefix, 'y') + "\"tail"));
+        EXPECT_EQ(prefix, find(std::string(prefix, 'y') + "\\"));
+        EXPECT_EQ(prefix + 5, find(std::string(prefix, 'y') + "12345"));
+    }
+}
@@ -90,3 +90,25 @@ TEST(RegExpTest, CMK1381) {
     EXPECT_FALSE(r.search("xyaz|"));
     EXPECT_TRUE(r.search("GNARK xy.z|KENU"));
 }
+
+TEST(RegExpTest, RequiredLiteral) {
+    EXPECT_EQ("web", RegExp::requiredLiteral("^web[0-9]+"));
+    EXPECT_EQ("barbaz", RegExp::requiredLiteral("foo.*barbaz"));
+    EXPECT_EQ("abc", RegExp::requiredLiteral("abc+def"));
+
+    // optional or alternated parts must not yield a literal
+    EXPECT_EQ("", RegExp::requiredLiteral("web|db"));
+    EXPECT_EQ("", RegExp::requiredLiteral("ab?c"));
+    EXPECT_EQ("", RegExp::requiredLiteral("(foo)"));
+
+    // short literals are not worth a prescan
+    EXPECT_EQ("", RegExp::requiredLiteral("ab"));
+}
+
+TEST(RegExpTest, SearchWithLiteralPrefilter) {
+    RegExp r{"^web[0-9]+", RegExp::Case::respect, RegExp::Syntax::pattern};
+    EXPECT_TRUE(r.search("web42 down"));
+    EXPECT_FALSE(r.search("db1 down"));
+    EXPECT_TRUE(r.match("web7"));
+    EXPECT_FALSE(r.match("xweb7"));
+}
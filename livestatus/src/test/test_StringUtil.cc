@@ -177,3 +177,17 @@ TEST(StringUtilTest, FormattedBitSet) {
     EXPECT_EQ("{7}", format_bitset<8>(0b10000000));
     EXPECT_EQ("{1, 2, 4, 5, 7}", format_bitset<8>(0b10110110));
 }
+
+TEST(StringUtilTest, SplitView) {
+    using svv = std::vector<std::string_view>;
+    EXPECT_EQ(svv{}, mk::splitView("", ';'));
+    EXPECT_EQ((svv{"a", "b", "c"}), mk::splitView("a;b;c", ';'));
+    EXPECT_EQ((svv{"a", "", "c"}), mk::splitView("a;;c", ';'));
+    EXPECT_EQ((svv{"a", ""}), mk::splitView("a;", ';'));
+    EXPECT_EQ(svv{"abc"}, mk::splitView("abc", ';'));
+
+    // the views alias the input
+    std::string input{"x;y"};
+    auto fields = mk::splitView(input, ';');
+    EXPECT_EQ(input.data(), fields[0].data());
+}
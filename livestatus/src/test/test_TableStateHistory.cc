@@ -0,0 +1,138 @@
+// Copyright (C) 2019 tribe29 GmbH - License: GNU General Public License v2
+// This file is part of Checkmk (https://checkmk.com). It is subject to the
+// terms and conditions defined in the file COPYING, which is part of this
+// source code package.
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "LogCache.h"
+#include "NagiosCore.h"
+#include "NagiosGlobals.h"
+#include "TableQueryHelper.h"
+#include "TableStateHistory.h"
+#include "data_encoding.h"
+#include "gtest/gtest.h"
+#include "nagios.h"
+#include "test/Utilities.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+host *makeHost(const char *name) {
+    auto *hst = new host();
+    memset(hst, 0, sizeof(host));
+    hst->name = strdup(name);
+    hst->address = strdup("127.0.0.1");
+    return hst;
+}
+
+void freeHost(host *hst) {
+    free(hst->name);
+    free(hst->address);
+    delete hst;
+}
+}  // namespace
+
+// The statehist replay is driven by a real logfile on disk: the fixture
+// writes one with two hosts, "beta" appearing only late in the log, so
+// that which objects a replay knows about depends on its timeframe.
+class TableStateHistoryFixture : public ::testing::Test {
+public:
+    const fs::path basepath{fs::temp_directory_path() / "statehist_tests" /
+                            random_string(12)};
+
+    void SetUp() override {
+        fs::create_directories(basepath / "archive");
+        std::ofstream ofs(basepath / "nagios.log");
+        ofs << "[1659999100] HOST ALERT: alpha;DOWN;HARD;1;down\n"
+            << "[1660000000] HOST ALERT: alpha;UP;HARD;1;up\n"
+            << "[1660005000] HOST ALERT: beta;DOWN;HARD;1;down\n";
+        ofs.close();
+
+        logfile_path_ = (basepath / "nagios.log").string();
+        archive_path_ = (basepath / "archive").string();
+        saved_log_file_ = log_file;
+        saved_log_archive_path_ = log_archive_path;
+        log_file = logfile_path_.data();
+        log_archive_path = archive_path_.data();
+
+        saved_host_list_ = host_list;
+        host_alpha_ = makeHost("alpha");
+        host_beta_ = makeHost("beta");
+        host_alpha_->next = host_beta_;
+        host_list = host_alpha_;
+    }
+
+    void TearDown() override {
+        host_list = saved_host_list_;
+        freeHost(host_beta_);
+        freeHost(host_alpha_);
+        log_file = saved_log_file_;
+        log_archive_path = saved_log_archive_path_;
+        fs::remove_all(basepath);
+    }
+
+    std::string queryFresh(const std::list<std::string> &q) {
+        LogCache log_cache{&core_};
+        TableStateHistory table{&core_, &log_cache};
+        return mk::test::query(table, q);
+    }
+
+    std::map<unsigned long, std::unique_ptr<Downtime>> downtimes_;
+    std::map<unsigned long, std::unique_ptr<Comment>> comments_;
+    NagiosCore core_{downtimes_,          comments_,
+                     NagiosPaths{},       NagiosLimits{},
+                     NagiosAuthorization{}, Encoding::utf8};
+
+private:
+    std::string logfile_path_;
+    std::string archive_path_;
+    char *saved_log_file_{nullptr};
+    char *saved_log_archive_path_{nullptr};
+    host *saved_host_list_{nullptr};
+    host *host_alpha_{nullptr};
+    host *host_beta_{nullptr};
+};
+
+namespace {
+std::list<std::string> stateQuery(const std::string &since,
+                                  const std::string &until) {
+    return {"GET statehist", "Columns: host_name state from until duration",
+            "Filter: time >= " + since, "Filter: time <= " + until};
+}
+}  // namespace
+
+TEST_F(TableStateHistoryFixture, SameWindowIsServedFromTheStore) {
+    LogCache log_cache{&core_};
+    TableStateHistory table{&core_, &log_cache};
+    auto q = stateQuery("1659999000", "1660007000");
+    auto first = mk::test::query(table, q);
+    EXPECT_NE("", first);
+    // the repeat is answered from the materialized intervals and must be
+    // byte-identical
+    EXPECT_EQ(first, mk::test::query(table, q));
+}
+
+TEST_F(TableStateHistoryFixture, NarrowerWindowMatchesFreshReplay) {
+    LogCache log_cache{&core_};
+    TableStateHistory table{&core_, &log_cache};
+    // The wide window sees beta's first event, a replay over the narrow
+    // one must not: serving the narrow query by clipping the wide
+    // materialization would add a beta row with state -1 and shift
+    // alpha's pre-window state. The answer after the wide query has to
+    // match a classic replay in a fresh table exactly.
+    auto wide = stateQuery("1659999000", "1660007000");
+    auto narrow = stateQuery("1659999500", "1660003000");
+    auto wide_result = mk::test::query(table, wide);
+    auto narrow_after_wide = mk::test::query(table, narrow);
+    EXPECT_NE(wide_result, narrow_after_wide);
+    EXPECT_EQ(queryFresh(narrow), narrow_after_wide);
+    // and flipping back to the wide window still matches, too
+    EXPECT_EQ(wide_result, mk::test::query(table, wide));
+}